@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+
+// Caps the render rate by sleeping until the next frame is due. Used instead of vsync so that time not spent
+// drawing can go to the simulation.
+class FrameLimiter {
+
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FrameLimiter(double target_fps = 60.0);
+
+    void setTargetFps(double fps);
+    double getTargetFps() const { return target_fps; }
+
+    Clock::time_point nextFrame() const { return next_frame; } // When the next frame should start
+    void wait();                                                // Sleep until nextFrame(), then schedule the one after
+
+  private:
+    double target_fps;
+    Clock::duration frame_period;
+    Clock::time_point next_frame;
+};
@@ -1,8 +1,18 @@
 #pragma once
 
+#include "metrics_window.hpp"
+#include "network_viewer.hpp"
+#include "profiler_window.hpp"
+
 #include <SDL_video.h>
 #include <imgui.h>
 
+namespace sim {
+class SimulationThread;
+} // namespace sim
+
+class WorldView;
+
 class ImGuiHandler {
 
   public:
@@ -13,4 +23,20 @@ class ImGuiHandler {
     void Shutdown();
 
     void initDefaultLayout();
+
+    // Simulation shown in the Control Panel. Not owned; must outlive the handler.
+    void setSimulation(sim::SimulationThread* sim_thread);
+
+    // Off-screen world shown in the World window. Not owned; must outlive the handler.
+    void setWorldView(WorldView* world_view);
+
+  private:
+    void drawControlPanel();
+    void drawWorldWindow();
+
+    sim::SimulationThread* sim_thread = nullptr;
+    WorldView* world_view = nullptr;
+    MetricsWindow metrics_window;
+    NetworkViewer network_viewer;
+    ProfilerWindow profiler_window;
 };
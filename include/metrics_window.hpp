@@ -0,0 +1,38 @@
+#pragma once
+
+#include "sim/metric_store.hpp"
+
+#include <imgui.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace sim {
+class SimulationThread;
+} // namespace sim
+
+// The "Encounter Metrics" window: boss and party health, threat shares by role and the showcase reward, plotted
+// per tick. Each plot asks the store for about one min/max bucket per pixel column, so drawing costs the same
+// after a minute or a day of history.
+class MetricsWindow {
+
+  public:
+    void draw(const sim::SimulationThread* sim_thread);
+
+    // Options, shown in the window
+    float span_ticks = 3600.0f; // Width of the plots, in sim ticks
+    bool whole_run = false;     // Ignore span_ticks and show everything kept
+
+  private:
+    // Draws `series` on one set of axes. Equal y_min and y_max fit the axes to the data.
+    void drawPlot(const char* id, const sim::MetricStore& store, std::initializer_list<std::size_t> series,
+                  float y_min, float y_max, float height);
+
+    std::uint64_t first = 0, last = 0; // Tick span being plotted this frame
+
+    // Reused every frame
+    std::vector<std::vector<sim::MetricBucket>> buckets;
+    std::vector<ImVec2> upper, lower;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace neat {
+
+// Bump allocator for data that all dies at once (a generation's genes). Allocation is a pointer bump,
+// deallocation is a no-op, and reset() throws everything away in one go while keeping the blocks for reuse,
+// so once a run reaches its high-water mark it stops touching malloc entirely.
+//
+// Plugs into std::pmr containers as a memory_resource. Not thread-safe.
+class Arena : public std::pmr::memory_resource {
+
+  public:
+    explicit Arena(std::size_t block_size = 1 << 20);
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // Invalidates everything allocated so far. Blocks are kept, not freed.
+    void reset();
+
+    std::size_t bytesUsed() const { return used; }         // Since the last reset
+    std::size_t bytesReserved() const { return reserved; } // Held in blocks, used or not
+
+  private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    bool fitsInBlock(std::size_t block, std::size_t bytes, std::size_t alignment) const;
+
+    std::size_t block_size;
+    std::vector<Block> blocks;
+    std::size_t current = 0; // Block being bumped
+    std::size_t offset = 0;  // Next free byte in it
+
+    std::size_t used = 0;
+    std::size_t reserved = 0;
+};
+
+} // namespace neat
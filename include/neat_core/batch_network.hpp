@@ -0,0 +1,80 @@
+#pragma once
+
+#include "neat_core/network.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace neat {
+
+// Networks with identical compiled programs (same ops, same edge sources) - they differ only in weights.
+bool sameTopology(const Network &a, const Network &b);
+std::uint64_t topologyHash(const Network &network);
+
+// Up to `lanes` same-topology networks evaluated lane-parallel: activation values and weights are interleaved
+// (value[node * lanes + lane]), so one sweep over the shared program advances every lane at once with SIMD.
+//
+// Uses AVX2 (+FMA) when the build targets it, SSE2 otherwise, and plain scalar code as a last resort.
+class NetworkBatch {
+
+  public:
+    static constexpr std::size_t lanes = 8;
+
+    // All networks must satisfy sameTopology() with the first. count must be in [1, lanes].
+    NetworkBatch(const Network *const *networks, std::size_t count);
+
+    // inputs: laneCount() rows of numInputs() floats. outputs: laneCount() rows of numOutputs() floats.
+    void activate(const float *inputs, float *outputs);
+
+    // Same, with one row pointer per lane, for callers whose rows aren't contiguous.
+    void activate(const float *const *lane_inputs, float *const *lane_outputs);
+
+    std::size_t laneCount() const { return lane_count; }
+    std::size_t valueCount() const { return values.size() / lanes; } // Per lane, as Network::valueCount()
+
+    // One lane's activation buffer as of the last activate(), in Network::activations() order. Writes
+    // valueCount() floats.
+    void laneActivations(std::size_t lane, float *out) const;
+    std::uint32_t numInputs() const { return num_inputs; }
+    std::uint32_t numOutputs() const { return num_outputs; }
+
+  private:
+    std::size_t lane_count;
+    std::uint32_t num_inputs;
+    std::uint32_t num_outputs;
+
+    std::vector<Network::NodeOp> node_ops; // Shared by every lane
+    std::vector<std::uint32_t> edge_source;
+    std::vector<float> edge_weight; // edge * lanes + lane
+    std::vector<float> values;      // node * lanes + lane
+};
+
+// A whole set of networks (e.g. a generation's phenotypes) grouped by topology. Groups with a few members run
+// as NetworkBatches; networks with no twin run on their own through the scalar path.
+//
+// Grouping costs several activations' worth per network (neat_bench group_generation), so build one per episode
+// and step it many times; rebuilding it for a handful of activations is slower than the scalar path.
+class BatchedNetworks {
+
+  public:
+    explicit BatchedNetworks(const std::vector<Network> &networks, std::size_t min_batch = 2);
+
+    // inputs/outputs hold one row per network, in the same order as the vector given to the constructor.
+    void activate(const float *inputs, float *outputs);
+
+    std::size_t batchCount() const { return batches.size(); }
+    std::size_t scalarCount() const { return scalar_members.size(); }
+
+  private:
+    std::vector<Network> scalar_networks;
+    std::vector<std::uint32_t> scalar_members; // Index into the original vector, per scalar network
+
+    std::vector<NetworkBatch> batches;
+    std::vector<std::uint32_t> batch_members; // lanes entries per batch, index into the original vector
+
+    std::uint32_t num_inputs = 0;
+    std::uint32_t num_outputs = 0;
+};
+
+} // namespace neat
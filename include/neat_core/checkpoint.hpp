@@ -0,0 +1,127 @@
+#pragma once
+
+#include "neat_core/genome.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace neat {
+
+// Binary checkpoints: a fixed header followed by flat arrays, little-endian, each section 8-byte aligned. Every
+// genome's genes are concatenated into one array per field (same SoA layout as Genome itself), so loading is a
+// memory map plus one bulk copy per genome - nothing is parsed gene by gene.
+//
+// Bump checkpoint_version whenever the layout changes; older files are rejected rather than misread.
+constexpr std::uint32_t checkpoint_version = 2;
+
+// Where one genome's genes sit in the flat arrays. The population's genomes come first, then one representative
+// per species, in species order.
+struct GenomeRecord {
+    std::uint64_t first_node = 0;
+    std::uint64_t first_connection = 0;
+    std::uint32_t node_count = 0;
+    std::uint32_t connection_count = 0;
+};
+
+struct SpeciesRecord {
+    std::uint64_t first_member = 0; // Into the member array
+    std::uint64_t last_improved = 0;
+    std::uint32_t id = 0;
+    std::uint32_t member_count = 0;
+    float best_fitness = 0.0f;
+    std::uint32_t padding = 0; // Keeps the record a multiple of 8 bytes
+};
+
+template <class T> struct ArrayView {
+    const T *data = nullptr;
+    std::size_t size = 0;
+
+    const T *begin() const { return data; }
+    const T *end() const { return data + size; }
+    const T &operator[](std::size_t i) const { return data[i]; }
+};
+
+template <class T> ArrayView<T> viewOf(const std::vector<T> &v) { return {v.data(), v.size()}; }
+
+// Everything needed to resume a run, as flat arrays. Points either into a PopulationSnapshot or straight into a
+// mapped file; Population::restore() and writeCheckpoint() only ever see this.
+struct CheckpointView {
+    std::uint64_t seed = 0; // Run seed
+    std::uint64_t generation = 0;
+    std::uint32_t num_inputs = 0;
+    std::uint32_t num_outputs = 0;
+    std::uint32_t next_node_id = 0;
+    std::uint32_t next_innovation = 0;
+    std::uint32_t next_species_id = 0;
+    float best_fitness = 0.0f;
+
+    ArrayView<GenomeRecord> genomes; // Population, then species representatives
+    ArrayView<std::uint32_t> node_ids;
+    ArrayView<NodeType> node_types;
+    ArrayView<std::uint32_t> conn_innovation;
+    ArrayView<std::uint32_t> conn_in;
+    ArrayView<std::uint32_t> conn_out;
+    ArrayView<float> conn_weight;
+    ArrayView<std::uint8_t> conn_enabled;
+
+    ArrayView<SpeciesRecord> species;
+    ArrayView<std::uint32_t> members;
+
+    ArrayView<std::uint64_t> rng_state; // Breeding generator's xoshiro state; episodes re-derive theirs from seed
+
+    std::size_t populationSize() const { return genomes.size - species.size; }
+};
+
+// Owning copy of a population in checkpoint layout. Shares nothing with the population it was taken from, so it
+// can be written out while evolution carries on.
+struct PopulationSnapshot {
+    CheckpointView header; // Scalars only; view() fills in the arrays
+
+    std::vector<GenomeRecord> genomes;
+    std::vector<std::uint32_t> node_ids;
+    std::vector<NodeType> node_types;
+    std::vector<std::uint32_t> conn_innovation;
+    std::vector<std::uint32_t> conn_in;
+    std::vector<std::uint32_t> conn_out;
+    std::vector<float> conn_weight;
+    std::vector<std::uint8_t> conn_enabled;
+
+    std::vector<SpeciesRecord> species;
+    std::vector<std::uint32_t> members;
+
+    std::vector<std::uint64_t> rng_state;
+
+    void addGenome(const Genome &genome); // Appends its genes and a record for it
+    CheckpointView view() const;
+};
+
+// Streams the checkpoint to `path` section by section. Throws std::runtime_error if the file can't be written.
+void writeCheckpoint(const CheckpointView &checkpoint, const std::string &path);
+
+// Read-only memory map of a checkpoint file. The header and every record range are checked on open, so view()
+// can be trusted; its arrays point straight into the mapping and live as long as this object.
+class MappedCheckpoint {
+
+  public:
+    explicit MappedCheckpoint(const std::string &path); // Throws std::runtime_error if missing or malformed
+    ~MappedCheckpoint();
+
+    MappedCheckpoint(const MappedCheckpoint &) = delete;
+    MappedCheckpoint &operator=(const MappedCheckpoint &) = delete;
+
+    const CheckpointView &view() const { return checkpoint; }
+
+  private:
+    void validate(const std::string &path);
+    void release();
+
+    const std::byte *data = nullptr;
+    std::size_t size = 0;
+    std::vector<std::byte> fallback; // File contents on platforms without mmap
+
+    CheckpointView checkpoint;
+};
+
+} // namespace neat
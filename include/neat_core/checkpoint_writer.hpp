@@ -0,0 +1,69 @@
+#pragma once
+
+#include "neat_core/checkpoint.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace neat {
+
+// Writes checkpoints on a background thread, so persisting a run never holds up the next generation. The caller
+// hands over a snapshot (Population::snapshot()) and carries on. Each file is written under a temporary name,
+// synced to disk and renamed into place, so a crash or power cut mid-write leaves the previous checkpoint intact.
+//
+// At most `max_pending` snapshots wait in the queue. If evolution outruns the disk the oldest waiting one is
+// dropped for the newest rather than blocking - only the latest state is worth having anyway.
+class CheckpointWriter {
+
+  public:
+    explicit CheckpointWriter(std::size_t max_pending = 2);
+    ~CheckpointWriter(); // Finishes whatever is queued, then joins
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    // Queues `snapshot` to be written to `path`. Never waits on I/O.
+    void submit(PopulationSnapshot snapshot, std::string path);
+
+    // Blocks until everything submitted so far has been written (or has failed).
+    void flush();
+
+    std::uint64_t written() const;
+    std::uint64_t dropped() const;  // Superseded in the queue before they were written
+    std::string lastError() const; // Most recent failure, empty if there hasn't been one
+
+    // Most recent checkpoint that was written and renamed into place, but whose directory couldn't be synced, so the
+    // rename might not survive a power cut. Such checkpoints still count as written(). Empty if there hasn't been one.
+    std::string lastWarning() const;
+
+  private:
+    struct Job {
+        PopulationSnapshot snapshot;
+        std::string path;
+    };
+
+    void run();
+
+    std::size_t max_pending;
+
+    mutable std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable idle;
+    std::deque<Job> queue;
+    bool busy = false; // Worker is writing a job it already took off the queue
+    bool stopping = false;
+
+    std::uint64_t written_count = 0;
+    std::uint64_t dropped_count = 0;
+    std::string last_error;
+    std::string last_warning;
+
+    std::thread worker; // Last, so everything above exists before it starts
+};
+
+} // namespace neat
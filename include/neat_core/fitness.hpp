@@ -0,0 +1,49 @@
+#pragma once
+
+#include "neat_core/genome.hpp"
+#include "neat_core/network.hpp"
+#include "neat_core/rng.hpp"
+#include "neat_core/thread_pool.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace neat {
+
+// Plays one episode with `network` and returns its fitness (higher is better). Runs on pool threads, so it must
+// only touch its arguments - any randomness comes from `rng`.
+using EpisodeFunction = std::function<float(Network &network, Rng &rng)>;
+
+// Plays a batch of networks in one go (e.g. side-by-side instances of one world) and writes fitness[i] for
+// networks[i]. Same rules as EpisodeFunction: pool threads, arguments only.
+using BatchEpisodeFunction = std::function<void(std::vector<Network> &networks, Rng &rng, float *fitness)>;
+
+// Scores a whole generation in parallel. Every genome gets its own RNG stream derived from (run seed,
+// generation, genome index), so the scores depend only on the run seed - never on thread count or scheduling.
+class FitnessEvaluator {
+
+  public:
+    FitnessEvaluator(ThreadPool &pool, EpisodeFunction episode);
+
+    // Batch mode: the generation is cut into fixed runs of batch_size genomes, each played by one call. A batch's
+    // stream is keyed on its first genome, and the cut doesn't depend on the thread count, so neither do scores.
+    FitnessEvaluator(ThreadPool &pool, BatchEpisodeFunction batch_episode, std::size_t batch_size);
+
+    void evaluate(const std::vector<Genome> &genomes, std::uint64_t run_seed, std::uint64_t generation,
+                  std::vector<float> &fitness);
+
+    // The stream genome `index` gets in `generation`.
+    static Rng episodeRng(std::uint64_t run_seed, std::uint64_t generation, std::uint64_t index);
+
+  private:
+    ThreadPool &pool;
+    EpisodeFunction episode;
+    BatchEpisodeFunction batch_episode;
+    std::size_t batch_size = 1;
+};
+
+// XOR, the classic NEAT sanity check (2 inputs, 1 output). Fitness = (4 - total error)^2, so 16 is perfect.
+float xorEpisode(Network &network, Rng &rng);
+
+} // namespace neat
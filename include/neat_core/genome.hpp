@@ -0,0 +1,125 @@
+#pragma once
+
+#include "neat_core/innovation.hpp"
+#include "neat_core/rng.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+namespace neat {
+
+enum class NodeType : std::uint8_t { Input, Bias, Output, Hidden };
+
+struct MutationConfig {
+    float weight_mutate_rate = 0.8f;    // Chance a genome has its weights mutated at all
+    float weight_perturb_rate = 0.9f;   // Per weight: nudge it, otherwise replace it outright
+    float weight_perturb_power = 0.5f;  // Std-dev of a nudge
+    float weight_range = 2.0f;          // New and replaced weights are uniform in [-range, range]
+    float add_connection_rate = 0.05f;
+    float add_node_rate = 0.03f;
+    int add_connection_attempts = 20;   // Random (in, out) pairs tried before giving up
+    float disabled_inherit_rate = 0.75f; // Chance a gene disabled in either parent stays disabled in the child
+};
+
+struct CompatibilityConfig {
+    float excess_coefficient = 1.0f;
+    float disjoint_coefficient = 1.0f;
+    float weight_coefficient = 0.4f;
+    float threshold = 1.5f; // Same species below this. Lower than the paper's 3.0 since mismatches are normalised
+};
+
+// NEAT genome stored as structure-of-arrays. Nodes are kept sorted by id and connections sorted by innovation
+// number, each field in its own contiguous vector, so crossover, distance and mutation are linear walks over
+// flat arrays rather than pointer chasing through node objects.
+//
+// Node ids are laid out inputs, then bias, then outputs, then hidden nodes, so sorting by id also groups by type.
+// Networks are kept feed-forward: add-connection never creates a cycle.
+//
+// The arrays are std::pmr vectors, so a generation's genes can all come out of one Arena. Moves keep the
+// source's memory resource; to put a genome into a different one, use the resource-taking copy constructor.
+class Genome {
+
+  public:
+    explicit Genome(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    Genome(const Genome &other, std::pmr::memory_resource *resource); // Copy into `resource`
+
+    Genome(const Genome &) = default; // Copies use the default resource
+    Genome(Genome &&) noexcept = default;
+    Genome &operator=(const Genome &) = default;
+    Genome &operator=(Genome &&) = default;
+
+    // Inputs + bias fully connected to the outputs, with random weights. Innovation numbers for these
+    // connections are fixed (see minimalInnovationCount()), so every minimal genome lines up with every other.
+    static Genome minimal(std::uint32_t num_inputs, std::uint32_t num_outputs, Rng &rng, const MutationConfig &config,
+                          std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    // Rebuilds a genome from raw gene arrays (nodes sorted by id, connections by innovation), e.g. straight out
+    // of a checkpoint.
+    static Genome fromGenes(std::uint32_t num_inputs, std::uint32_t num_outputs, const std::uint32_t *node_ids,
+                            const NodeType *node_types, std::size_t node_count, const std::uint32_t *innovations,
+                            const std::uint32_t *in, const std::uint32_t *out, const float *weights,
+                            const std::uint8_t *enabled, std::size_t connection_count,
+                            std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    // Ids/innovations used by minimal(), so a registry knows where to start handing out new ones.
+    static std::uint32_t minimalNodeCount(std::uint32_t num_inputs, std::uint32_t num_outputs);
+    static std::uint32_t minimalInnovationCount(std::uint32_t num_inputs, std::uint32_t num_outputs);
+
+    // Child of two parents. Matching genes are picked at random, disjoint and excess genes come from `fitter`.
+    static Genome crossover(const Genome &fitter, const Genome &other, Rng &rng, const MutationConfig &config,
+                            std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    // Standard NEAT distance: (c1 * excess + c2 * disjoint) / N + c3 * mean weight difference of matching genes.
+    // Gives up as soon as the distance is known to be over `limit`, returning some value above it; distances
+    // within the limit are exact.
+    static float compatibilityDistance(const Genome &a, const Genome &b, const CompatibilityConfig &config,
+                                       float limit = std::numeric_limits<float>::infinity());
+
+    void mutate(Rng &rng, InnovationRegistry &registry, const MutationConfig &config);
+    void mutateWeights(Rng &rng, const MutationConfig &config);
+    bool mutateAddConnection(Rng &rng, InnovationRegistry &registry, const MutationConfig &config);
+    bool mutateAddNode(Rng &rng, InnovationRegistry &registry);
+
+    std::uint32_t numInputs() const { return num_inputs; }
+    std::uint32_t numOutputs() const { return num_outputs; }
+
+    std::size_t nodeCount() const { return node_ids.size(); }
+    const std::pmr::vector<std::uint32_t> &nodeIds() const { return node_ids; }
+    const std::pmr::vector<NodeType> &nodeTypes() const { return node_types; }
+
+    std::size_t connectionCount() const { return conn_innovation.size(); }
+    const std::pmr::vector<std::uint32_t> &connectionInnovations() const { return conn_innovation; }
+    const std::pmr::vector<std::uint32_t> &connectionIn() const { return conn_in; }
+    const std::pmr::vector<std::uint32_t> &connectionOut() const { return conn_out; }
+    const std::pmr::vector<float> &connectionWeights() const { return conn_weight; }
+    const std::pmr::vector<std::uint8_t> &connectionEnabled() const { return conn_enabled; }
+
+    // Index of node `id` in the node arrays, or nodeCount() if it isn't in this genome.
+    std::size_t nodeIndex(std::uint32_t id) const;
+
+  private:
+    void addNode(std::uint32_t id, NodeType type); // Sorted insert
+    void addConnection(std::uint32_t innovation, std::uint32_t in, std::uint32_t out, float weight, bool enabled);
+    void reserveConnections(std::size_t count);
+    bool hasConnection(std::uint32_t in, std::uint32_t out) const;
+    bool createsCycle(std::uint32_t in, std::uint32_t out) const; // Would in -> out close a loop?
+
+    std::uint32_t num_inputs = 0;
+    std::uint32_t num_outputs = 0;
+
+    // Nodes, sorted by id
+    std::pmr::vector<std::uint32_t> node_ids;
+    std::pmr::vector<NodeType> node_types;
+
+    // Connections, sorted by innovation number
+    std::pmr::vector<std::uint32_t> conn_innovation;
+    std::pmr::vector<std::uint32_t> conn_in;
+    std::pmr::vector<std::uint32_t> conn_out;
+    std::pmr::vector<float> conn_weight;
+    std::pmr::vector<std::uint8_t> conn_enabled;
+};
+
+} // namespace neat
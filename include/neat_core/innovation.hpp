@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace neat {
+
+// Hands out innovation numbers and node ids. The same structural mutation showing up more than once in a
+// generation gets the same numbers, so crossover can line the genes back up.
+//
+// Lookups go through open-addressing hash tables keyed on the (in, out) pair, split into independently locked
+// shards so parallel mutation rarely contends. Every slot carries the generation it was written in, so
+// newGeneration() just bumps a stamp instead of clearing memory.
+//
+// Thread-safe. Note that with several threads mutating at once, which of two new mutations gets the lower
+// number depends on scheduling.
+class InnovationRegistry {
+
+  public:
+    InnovationRegistry(std::uint32_t next_node_id, std::uint32_t next_innovation);
+
+    InnovationRegistry(const InnovationRegistry &) = delete;
+    InnovationRegistry &operator=(const InnovationRegistry &) = delete;
+
+    // Innovation number for a connection in -> out.
+    std::uint32_t connectionInnovation(std::uint32_t in, std::uint32_t out);
+
+    // Id of the hidden node created by splitting the connection in -> out.
+    std::uint32_t splitNode(std::uint32_t in, std::uint32_t out);
+
+    // Forget this generation's mutations; numbers already handed out stay unique. Not safe to call while
+    // other threads are using the registry.
+    void newGeneration();
+
+    // Next numbers to be handed out, for checkpoints.
+    std::uint32_t nextNodeId() const { return next_node_id.load(std::memory_order_relaxed); }
+    std::uint32_t nextInnovation() const { return next_innovation.load(std::memory_order_relaxed); }
+
+    // Carry on numbering from a checkpoint, forgetting this generation's mutations. Same threading caveat as
+    // newGeneration().
+    void restore(std::uint32_t node_id, std::uint32_t innovation);
+
+  private:
+    static constexpr unsigned shard_bits = 6;
+
+    // Open-addressing (linear probing) table. Slots whose stamp isn't the current generation count as empty.
+    class Table {
+
+      public:
+        Table();
+
+        // Value slot for `key` this generation, inserting an empty one if there wasn't one yet (`inserted`
+        // reports which). Valid until the next insert.
+        std::uint32_t &findOrInsert(std::uint64_t key, std::uint64_t hash, std::uint32_t stamp, bool &inserted);
+        void clearStamps();
+
+      private:
+        struct Slot {
+            std::uint64_t key = 0;
+            std::uint32_t value = 0;
+            std::uint32_t stamp = 0; // 0 never matches a live generation
+        };
+
+        void grow(std::uint32_t stamp);
+
+        std::vector<Slot> slots;
+        std::size_t live = 0;
+        std::uint32_t live_stamp = 0;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        Table connections;
+        Table splits;
+    };
+
+    std::uint32_t lookup(Table Shard::*table, std::atomic<std::uint32_t> &counter, std::uint32_t in,
+                         std::uint32_t out);
+
+    std::unique_ptr<Shard[]> shards;
+    std::uint32_t stamp = 1;
+
+    std::atomic<std::uint32_t> next_node_id;
+    std::atomic<std::uint32_t> next_innovation;
+};
+
+} // namespace neat
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "neat_core/genome.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace neat {
+
+// Steepened sigmoid from the original NEAT paper.
+inline float neuronActivation(float x) { return 1.0f / (1.0f + std::exp(-4.9f * x)); }
+
+// Phenotype compiled from a Genome. The genome is topologically sorted once, then flattened into a list of
+// node ops that index straight into a dense activation buffer, so activating the network is a linear loop with
+// no lookups, recursion or per-tick allocation.
+//
+// Buffer layout matches the genome's node order: inputs, bias, outputs, then hidden nodes.
+class Network {
+
+  public:
+    // One non-input node: sum edges [first_edge, first_edge + edge_count) into values[target].
+    struct NodeOp {
+        std::uint32_t target;
+        std::uint32_t first_edge;
+        std::uint32_t edge_count;
+    };
+
+    Network() = default;
+
+    static Network compile(const Genome &genome);
+
+    // Reads numInputs() values from `inputs`, writes numOutputs() values to `outputs`.
+    void activate(const float *inputs, float *outputs);
+
+    std::uint32_t numInputs() const { return num_inputs; }
+    std::uint32_t numOutputs() const { return num_outputs; }
+    std::size_t valueCount() const { return values.size(); }
+    std::uint32_t outputOffset() const { return num_inputs + 1; } // First output in the activation buffer
+
+    // Compiled program, exposed for evaluators that run it themselves.
+    const std::vector<NodeOp> &ops() const { return node_ops; }
+    const std::vector<std::uint32_t> &edgeSources() const { return edge_source; }
+    const std::vector<float> &edgeWeights() const { return edge_weight; }
+
+    // Activation buffer as of the last activate() call.
+    const std::vector<float> &activations() const { return values; }
+
+  private:
+    std::uint32_t num_inputs = 0;
+    std::uint32_t num_outputs = 0;
+
+    std::vector<NodeOp> node_ops; // In evaluation order
+    std::vector<std::uint32_t> edge_source;
+    std::vector<float> edge_weight;
+    std::vector<float> values;
+};
+
+} // namespace neat
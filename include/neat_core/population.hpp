@@ -0,0 +1,110 @@
+#pragma once
+
+#include "neat_core/arena.hpp"
+#include "neat_core/checkpoint.hpp"
+#include "neat_core/fitness.hpp"
+#include "neat_core/genome.hpp"
+#include "neat_core/innovation.hpp"
+#include "neat_core/rng.hpp"
+#include "neat_core/thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace neat {
+
+struct PopulationConfig {
+    std::size_t size = 150;
+    std::uint64_t seed = 1;
+
+    std::uint32_t num_inputs = 2; // XOR-sized; sim::Simulation sets these for its task
+    std::uint32_t num_outputs = 1;
+
+    MutationConfig mutation;
+    CompatibilityConfig compatibility;
+
+    float crossover_rate = 0.75f;        // Otherwise the child is a mutated clone of one parent
+    float survival_threshold = 0.2f;     // Top fraction of each species allowed to breed
+    std::size_t species_elite_size = 5;  // Species at least this big pass their champion on unchanged
+    std::uint64_t stagnation_limit = 15; // Generations without improvement before a species stops breeding
+};
+
+struct Species {
+    std::uint32_t id = 0;
+    Genome representative;              // Copy of a member of the previous generation; new genomes are compared to it
+    std::vector<std::uint32_t> members; // Indices into the population's genomes
+
+    float best_fitness = -std::numeric_limits<float>::infinity(); // Best ever, for stagnation
+    std::uint64_t last_improved = 0;                               // Generation best_fitness last went up
+};
+
+// Owns one generation of genomes and steps evolution forward one epoch at a time.
+// No graphics dependencies, so it can be driven by the GUI or by the headless runner.
+class Population {
+
+  public:
+    // `pool` (optional, not owned) parallelises speciation.
+    explicit Population(const PopulationConfig &config, ThreadPool *pool = nullptr);
+
+    void epoch(FitnessEvaluator &evaluator); // Evaluate the current generation and breed the next one
+
+    std::size_t size() const { return genomes.size(); }
+    std::uint64_t generation() const { return generation_count; }
+    std::uint64_t seed() const { return config.seed; }
+    float bestFitness() const { return best_fitness; }
+    const std::vector<Genome> &getGenomes() const { return genomes; }
+    const std::vector<float> &getFitness() const { return fitness; }
+    const std::vector<Species> &getSpecies() const { return species; }
+
+    // Sorts the current generation into species again, each genome trying its current species first. epoch()
+    // already does this for every new generation; this is for benchmarks and tools.
+    void respeciate();
+
+    // Flat copy of everything needed to carry on from here: genomes, species, innovation counters and RNG state.
+    // Take it between epochs.
+    PopulationSnapshot snapshot() const;
+
+    // Replaces this population with a checkpointed one. Input/output counts must match the config; the
+    // checkpoint's seed and size take over. Throws std::runtime_error if it doesn't fit.
+    void restore(const CheckpointView &checkpoint);
+
+    std::size_t geneBytesReserved() const { return arenas[0].bytesReserved() + arenas[1].bytesReserved(); }
+
+  private:
+    static constexpr std::uint32_t no_species = std::numeric_limits<std::uint32_t>::max();
+
+    void evaluate(FitnessEvaluator &evaluator);
+    void updateSpeciesStats();
+    void reproduce();
+    std::vector<std::size_t> allotOffspring() const;
+
+    // Sorts the current genomes into species. hints[i] is the species genome i tries first (its parent's).
+    void speciate(const std::vector<std::uint32_t> &hints);
+    // First species in [first, last) (trying `hint` before the rest) whose representative is close enough.
+    std::uint32_t findSpecies(const Genome &genome, std::uint32_t hint, std::size_t first, std::size_t last) const;
+
+    PopulationConfig config;
+    ThreadPool *pool;
+    Rng rng;
+    InnovationRegistry innovations;
+
+    std::uint64_t generation_count = 0;
+    float best_fitness = 0.0f;
+
+    // Double-buffered gene storage: the current generation's genes live in arenas[parent_arena] and children are
+    // bred into the other one. Once the children take over, the old arena is reset wholesale, so reproduction
+    // never mallocs or frees per gene and memory stays flat however long the run goes.
+    Arena arenas[2];
+    std::size_t parent_arena = 0;
+
+    std::vector<Genome> genomes;
+    std::vector<Genome> offspring; // Next generation while it's being bred; kept around for its capacity
+    std::vector<float> fitness;    // One score per genome, same indexing as `genomes`
+
+    std::vector<Species> species;
+    std::uint32_t next_species_id = 0;
+};
+
+} // namespace neat
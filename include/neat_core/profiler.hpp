@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace neat {
+
+// One timed scope, recorded when it closes. Times are nanoseconds since the profiler started.
+struct ProfileEvent {
+    const char *name; // Must outlive the profiler - in practice always a string literal
+    std::uint64_t start_ns;
+    std::uint64_t end_ns;
+    std::uint32_t depth; // Scopes open on the same thread around this one
+};
+
+// Hierarchical scope profiler. Every thread writes its events into its own fixed-size ring, so recording is a
+// couple of clock reads and stores with no locks and no allocation; readers (ProfileReader) copy new events out
+// whenever they like. If a reader falls more than a ring behind, the oldest events are lost, never the newest.
+//
+// Use the NEAT_PROFILE_SCOPE macro rather than this directly - it compiles away when NEAT_PROFILER is off.
+class Profiler {
+
+  public:
+    static constexpr std::size_t ring_capacity = std::size_t(1) << 14; // Events per thread (32 bytes each)
+
+    // Runtime switch (on by default). Scopes opened while disabled record nothing.
+    static void setEnabled(bool enabled);
+    static bool enabled();
+
+    // Label for the calling thread's events, e.g. "sim" or "worker 2".
+    static void setThreadName(const std::string &name);
+
+    static std::uint64_t now();
+
+    static void record(const char *name, std::uint64_t start_ns, std::uint64_t end_ns, std::uint32_t depth);
+
+    // Nesting depth bookkeeping for ProfileScope.
+    static std::uint32_t enterScope();
+    static void leaveScope();
+};
+
+// Times its own lifetime.
+class ProfileScope {
+
+  public:
+    explicit ProfileScope(const char *name)
+    {
+        if (Profiler::enabled())
+        {
+            this->name = name;
+            depth = Profiler::enterScope();
+            start = Profiler::now();
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if (name)
+        {
+            Profiler::record(name, start, Profiler::now(), depth);
+            Profiler::leaveScope();
+        }
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+  private:
+    const char *name = nullptr;
+    std::uint64_t start = 0;
+    std::uint32_t depth = 0;
+};
+
+// Collects what every thread recorded since this reader's last poll(). Each reader keeps its own position, so
+// several (the GUI, a trace exporter) can read independently. Not thread-safe itself; one owner per reader.
+class ProfileReader {
+
+  public:
+    struct ThreadEvents {
+        std::uint32_t thread_id = 0; // Stable for the life of the process, in order of first event
+        std::string thread_name;
+        std::vector<ProfileEvent> events; // In the order they closed
+        std::uint64_t dropped = 0;        // Overwritten before this reader got to them
+    };
+
+    // One entry per thread that has recorded anything, with only the new events (possibly none).
+    std::vector<ThreadEvents> poll();
+
+  private:
+    std::vector<std::uint64_t> cursors; // By thread id
+};
+
+} // namespace neat
+
+#if NEAT_PROFILER
+#define NEAT_PROFILE_CONCAT_(a, b) a##b
+#define NEAT_PROFILE_CONCAT(a, b) NEAT_PROFILE_CONCAT_(a, b)
+// Times the enclosing scope under `name` (a string literal).
+#define NEAT_PROFILE_SCOPE(name) ::neat::ProfileScope NEAT_PROFILE_CONCAT(neat_profile_scope_, __LINE__)(name)
+#else
+#define NEAT_PROFILE_SCOPE(name) ((void)0)
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace neat {
+
+// What a stream is for, so the same run seed gives unrelated streams to different jobs.
+enum class RngStream : std::uint64_t { Breeding, Episode, Showcase };
+
+// xoshiro256** - four words of state, a handful of shifts and a multiply per draw. Always passed in explicitly,
+// there is no global generator.
+//
+// Everything below is defined here rather than left to <random>'s distributions, whose output differs between
+// standard libraries, so a run seed reproduces the same run bit for bit on any platform and thread count.
+class Rng {
+
+  public:
+    using result_type = std::uint64_t;
+    using State = std::array<std::uint64_t, 4>;
+
+    explicit Rng(std::uint64_t seed = 0);
+
+    // Independent generator for one job within a run, e.g. (seed, Episode, generation, genome). The keys are
+    // hashed, so neighbouring keys still give unrelated streams, and no generator has to be shared or locked.
+    static Rng stream(std::uint64_t seed, RngStream purpose, std::uint64_t key0 = 0, std::uint64_t key1 = 0);
+
+    // Child generator seeded from this one's next draw, e.g. one per thread.
+    Rng split() { return Rng((*this)()); }
+
+    result_type operator()()
+    {
+
+        const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+
+        return result;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    // Raw state, for checkpoints. An all-zero state is invalid (the generator would be stuck at zero).
+    const State &state() const { return s; }
+    bool setState(const State &state);
+
+  private:
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    State s;
+};
+
+// Uniform in [0, 1), from the top 24 bits so every value is exactly representable.
+inline float randomUnit(Rng &rng) { return static_cast<float>(rng() >> 40) * 0x1.0p-24f; }
+
+inline float randomFloat(Rng &rng, float lo, float hi) { return lo + (hi - lo) * randomUnit(rng); }
+
+inline bool randomChance(Rng &rng, float probability) { return randomUnit(rng) < probability; }
+
+// Standard normal (Marsaglia polar method, second value discarded so the state stays just the four words).
+inline float randomGaussian(Rng &rng)
+{
+
+    float u, v, s;
+    do
+    {
+        u = randomFloat(rng, -1.0f, 1.0f);
+        v = randomFloat(rng, -1.0f, 1.0f);
+        s = u * u + v * v;
+    } while (s >= 1.0f || s == 0.0f);
+
+    return u * std::sqrt(-2.0f * std::log(s) / s);
+}
+
+// Uniform index in [0, count). count must be non-zero. Unbiased: draws in the short last bucket are rejected.
+inline std::size_t randomIndex(Rng &rng, std::size_t count)
+{
+
+    const std::uint64_t range = count;
+    const std::uint64_t threshold = (0 - range) % range; // 2^64 mod range
+    std::uint64_t x = rng();
+    while (x < threshold)
+    {
+        x = rng();
+    }
+    return static_cast<std::size_t>(x % range);
+}
+
+} // namespace neat
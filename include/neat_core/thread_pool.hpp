@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace neat {
+
+// Work-stealing thread pool. Each thread has its own task deque: it pops its own work from the back and, when
+// that runs dry, steals from the front of everybody else's. The thread calling parallelFor() joins in too, so a
+// pool of N threads runs N - 1 workers.
+class ThreadPool {
+
+  public:
+    // 0 = one thread per hardware core.
+    explicit ThreadPool(std::size_t thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    std::size_t threadCount() const { return queues.size(); } // Workers + the calling thread
+
+    // Calls body(begin, end) over chunks covering [0, count) and returns when all of them are done.
+    // grain = items per chunk, 0 picks one that gives each thread several chunks to steal. body must not throw.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)> &body,
+                     std::size_t grain = 0);
+
+  private:
+    struct Task {
+        const std::function<void(std::size_t, std::size_t)> *body;
+        std::size_t begin;
+        std::size_t end;
+        std::atomic<std::size_t> *remaining; // Chunks of this parallelFor still to finish
+    };
+
+    struct alignas(64) TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(std::size_t index);
+    bool findTask(std::size_t index, Task &task); // Own queue first, then steal
+    static void runTask(const Task &task);
+
+    std::vector<std::unique_ptr<TaskQueue>> queues; // One per worker, plus the last one for outside callers
+    std::vector<std::thread> workers;
+
+    std::atomic<std::size_t> pending{0}; // Tasks queued but not yet picked up
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+    bool stopping = false;
+};
+
+} // namespace neat
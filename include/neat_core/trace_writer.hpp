@@ -0,0 +1,68 @@
+#pragma once
+
+#include "neat_core/profiler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace neat {
+
+// Streams everything NEAT_PROFILE_SCOPE records to a Chrome trace event file (JSON array format), which
+// chrome://tracing and ui.perfetto.dev open as a per-thread timeline. A background thread drains the profiler's
+// per-thread rings every `interval` and appends to the file, so the instrumented threads never touch the disk.
+//
+// The array format tolerates a missing closing bracket, so a run that is killed still leaves a readable trace.
+// If a thread records more than Profiler::ring_capacity events between drains the oldest are lost; dropped()
+// counts them.
+class TraceWriter {
+
+  public:
+    // Opens `path` for writing; throws std::runtime_error if it can't be.
+    explicit TraceWriter(const std::string &path,
+                         std::chrono::milliseconds interval = std::chrono::milliseconds(100));
+    ~TraceWriter(); // finish()
+
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    // Writes what's left, closes the trace and stops the thread. The counters are final afterwards.
+    void finish();
+
+    const std::string &getPath() const { return path; }
+    std::uint64_t eventsWritten() const { return events_written.load(std::memory_order_relaxed); }
+    std::uint64_t dropped() const { return dropped_count.load(std::memory_order_relaxed); }
+    std::string lastError() const; // Empty unless a write failed
+
+  private:
+    void run();
+    void drain(); // Worker thread only
+
+    std::string path;
+    std::chrono::milliseconds interval;
+    std::ofstream file;
+
+    // Worker thread only
+    ProfileReader reader;
+    std::vector<std::string> thread_names; // As last written, by thread id
+    std::string buffer;
+    bool first_event = true;
+
+    std::atomic<std::uint64_t> events_written{0};
+    std::atomic<std::uint64_t> dropped_count{0};
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::string last_error;
+
+    std::thread worker; // Last, so everything above exists before it starts
+};
+
+} // namespace neat
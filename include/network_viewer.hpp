@@ -0,0 +1,88 @@
+#pragma once
+
+#include "neat_core/genome.hpp"
+
+#include <imgui.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sim {
+class SimulationThread;
+struct NetworkTopology;
+struct ActivationFrame;
+} // namespace sim
+
+// Where every node of a genome goes, in layout units (one between neighbours in a layer). Built once per topology:
+// inputs and bias on the left, outputs on the right, hidden nodes on their longest path from the inputs and
+// ordered within a layer by their neighbours' average height, which untangles most crossings.
+class NetworkLayout {
+
+  public:
+    struct Node {
+        float x = 0.0f, y = 0.0f;
+        neat::NodeType type = neat::NodeType::Hidden;
+    };
+
+    struct Edge {
+        std::uint32_t from = 0, to = 0;
+        float weight = 0.0f;
+        bool enabled = true;
+    };
+
+    void build(const sim::NetworkTopology& topology);
+
+    const std::vector<Node>& getNodes() const { return nodes; }
+    const std::vector<Edge>& getEdges() const { return edges; } // Strongest |weight| first
+    float maxWeight() const { return max_weight; }
+    std::uint32_t layerCount() const { return layer_count; }
+
+    // Number of leading edges with |weight| >= threshold.
+    std::size_t edgesAtLeast(float threshold) const;
+
+    // Bounding box of the nodes
+    float min_x = 0.0f, min_y = 0.0f, max_x = 0.0f, max_y = 0.0f;
+
+  private:
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    float max_weight = 0.0f;
+    std::uint32_t layer_count = 0;
+};
+
+// The "Network Viewer" window: the watched genome drawn with ImDrawList, rebuilt only when the sim publishes a new
+// topology. Weak connections are culled first when zoomed out or over the edge budget, so a genome with
+// thousands of connections draws in a bounded number of primitives. Wheel zooms about the cursor, drag pans.
+//
+// With Live on, nodes light up with the watched party member's current activations and connections with the
+// signal they carry (source activation * weight), refreshed every frame from the sim's latest ActivationFrame.
+class NetworkViewer {
+
+  public:
+    void draw(sim::SimulationThread* sim_thread);
+
+    // Options, shown in the window
+    float min_weight = 0.0f;       // Connections weaker than this aren't drawn
+    int edge_budget = 4000;        // Most connections drawn per frame, strongest first
+    bool show_disabled = false;
+    bool live = true; // Overlay activations
+
+  private:
+    void fit(const ImVec2& size);
+    void drawSlotPicker(sim::SimulationThread* sim_thread, const sim::ActivationFrame& frame);
+    void drawCanvas(const std::vector<float>* values); // values: one per node, or null for the plain topology
+
+    NetworkLayout layout;
+    std::uint64_t layout_version = 0;
+    std::size_t layout_genome = ~std::size_t(0);
+    std::uint64_t layout_builds = 0;
+
+    // View: screen = canvas origin + pan + layout * zoom
+    float zoom = 100.0f;
+    ImVec2 pan{0.0f, 0.0f};
+    bool fit_pending = true;
+
+    int genome_input = 0;
+    std::size_t edges_drawn = 0, nodes_drawn = 0;
+};
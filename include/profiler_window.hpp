@@ -0,0 +1,50 @@
+#pragma once
+
+#include "neat_core/profiler.hpp"
+#include "neat_core/trace_writer.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+// The "Profiler" window: a flame chart of the NEAT_PROFILE_SCOPE timings, one lane per thread (UI, sim, pool
+// workers) with nested scopes stacked below their parents, plus per-scope totals for the visible span. Keeps a
+// few seconds of history so a hitch can be frozen and looked at after the fact. A whole session can also be
+// streamed to a Chrome trace file for a proper trace viewer.
+class ProfilerWindow {
+
+  public:
+    // Collects whatever the threads recorded since last frame and draws the window. Call once per UI frame.
+    void draw();
+
+    // Options, shown in the window
+    float history_seconds = 10.0f; // Kept for scrolling back while frozen
+    float view_ms = 100.0f;        // Width of the chart
+
+  private:
+    struct Lane {
+        std::string name;
+        std::deque<neat::ProfileEvent> events; // In the order they closed, so sorted by end time
+        std::uint32_t max_depth = 0;
+        std::uint64_t dropped = 0;
+    };
+
+    void collect();
+    void drawLane(Lane& lane, std::uint64_t view_start, std::uint64_t view_end);
+    void drawTotals(std::uint64_t view_start, std::uint64_t view_end) const;
+    void drawTraceControls();
+
+    neat::ProfileReader reader;
+    std::vector<Lane> lanes; // By thread id
+
+    std::uint64_t latest_ns = 0; // Newest event end seen, the right edge of the chart unless frozen
+    bool frozen = false;
+    std::uint64_t frozen_end = 0;
+    float scroll_back_ms = 0.0f; // How far before frozen_end the chart ends
+
+    std::unique_ptr<neat::TraceWriter> trace; // Set while recording a trace file
+    char trace_path[256] = "trace.json";
+    std::string trace_status;
+};
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "neat_core/batch_network.hpp"
+#include "neat_core/network.hpp"
+#include "neat_core/rng.hpp"
+#include "sim/spatial_grid.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace sim {
+
+enum class Role : std::uint8_t { Tank, Healer, Dps };
+
+struct RoleStats {
+    float max_hp;
+    float speed;    // Units per second at full stick
+    float range;    // Ability reach
+    float power;    // Damage (tank, DPS) or healing (healer) per use
+    float cooldown; // Seconds between uses
+    float threat;   // Threat generated per point of damage or healing
+};
+
+struct EncounterConfig {
+    float dt = 1.0f / 60.0f;
+    std::uint32_t max_ticks = 60 * 30; // An encounter that runs this long ends as a wipe. The only limit on
+                                       // an evaluation episode's length - playEncounters doesn't watch the clock
+    float arena_half_size = 20.0f;     // Square arena centred on the origin
+
+    std::uint32_t dps_count = 3; // Party = tank, healer, then the DPS
+    float ally_radius = 6.0f;    // Reach of the "allies in range" sensor (matches the AoE, so it reads as clumping)
+
+    RoleStats tank{400.0f, 5.0f, 2.5f, 10.0f, 1.0f, 5.0f};
+    RoleStats healer{150.0f, 5.0f, 12.0f, 30.0f, 1.5f, 0.5f};
+    RoleStats dps{150.0f, 5.5f, 8.0f, 25.0f, 1.0f, 1.0f};
+
+    // Boss: chases whoever has the most threat and hits them in melee. Every aoe_period it marks the ground under
+    // its target and, aoe_warning seconds later, damages everyone still inside the circle.
+    float boss_hp = 2400.0f;
+    float boss_speed = 3.0f;
+    float boss_melee_range = 2.0f;
+    float boss_melee_damage = 40.0f;
+    float boss_attack_period = 1.5f;
+    float boss_aoe_period = 10.0f;
+    float boss_aoe_warning = 2.0f;
+    float boss_aoe_radius = 6.0f;
+    float boss_aoe_damage = 60.0f;
+
+    std::uint32_t partySize() const { return 2 + dps_count; }
+    const RoleStats &stats(Role role) const { return role == Role::Tank ? tank : role == Role::Healer ? healer : dps; }
+};
+
+// Many independent boss encounters stepped side by side. Every component is its own flat array (structure of
+// arrays) covering the agents of all instances, agent = instance * partySize() + slot, so a tick is a handful of
+// tight loops over whole arrays instead of per-object updates. Bosses get the same treatment, one entry per
+// instance.
+//
+// Deterministic: the only randomness is the start positions, drawn from the Rng given to reset().
+class EncounterWorld {
+
+  public:
+    // Per-agent network inputs, written by gatherSensors(). Positions are relative and scaled by the arena size.
+    static constexpr std::uint32_t sensor_count = 19;
+    // Per-agent network outputs read by applyControls(): move x, move y (0..1, centred on 0.5) and use ability.
+    static constexpr std::uint32_t control_count = 3;
+
+    EncounterWorld(const EncounterConfig &config, std::size_t instances);
+
+    // Restarts every instance. Parties spawn scattered near the south edge, the boss in the middle.
+    void reset(neat::Rng &rng);
+
+    // Writes sensor_count floats per agent, agent-major. Finished instances' rows are left as they were.
+    void gatherSensors(float *sensors) const;
+
+    // Reads control_count floats per agent, agent-major (network outputs as-is).
+    void applyControls(const float *controls);
+
+    // Advances every running instance by one tick.
+    void step();
+
+    bool allFinished() const { return running_count == 0; }
+    bool finished(std::size_t instance) const { return done[instance] != 0; }
+
+    // Higher is better: damage dealt to the boss, the party still standing, and a bonus for a kill (bigger the
+    // faster it came).
+    float score(std::size_t instance) const;
+
+    const EncounterConfig &getConfig() const { return config; }
+    std::size_t instanceCount() const { return instance_count; }
+    std::size_t agentCount() const { return hp.size(); }
+    std::uint32_t partySize() const { return party_size; }
+    std::uint32_t tickCount() const { return ticks; }
+
+    // Component arrays, for renderers and diagnostics.
+    const std::vector<Role> &roles() const { return role; }
+    const std::vector<float> &positionsX() const { return pos_x; }
+    const std::vector<float> &positionsY() const { return pos_y; }
+    const std::vector<float> &velocitiesX() const { return vel_x; }
+    const std::vector<float> &velocitiesY() const { return vel_y; }
+    const std::vector<float> &health() const { return hp; }
+    const std::vector<float> &threats() const { return threat; }
+    const std::vector<float> &cooldowns() const { return cooldown; }
+    const std::vector<float> &bossX() const { return boss_x; }
+    const std::vector<float> &bossY() const { return boss_y; }
+    const std::vector<float> &bossHealth() const { return boss_hp; }
+    const std::vector<float> &aoeX() const { return aoe_x; }
+    const std::vector<float> &aoeY() const { return aoe_y; }
+    const std::vector<float> &aoeTimers() const { return aoe_timer; } // > 0 while a marked circle is pending
+
+  private:
+    void integrate();
+    void tickCooldowns();
+    void useAbilities();
+    void updateBosses();
+    void updateLiveness();
+
+    EncounterConfig config;
+    std::size_t instance_count;
+    std::uint32_t party_size;
+    std::uint32_t ticks = 0;
+    std::size_t running_count = 0;
+
+    // Agents
+    std::vector<Role> role;
+    std::vector<float> pos_x, pos_y;
+    std::vector<float> vel_x, vel_y;
+    std::vector<float> hp;
+    std::vector<float> threat; // Towards their instance's boss
+    std::vector<float> cooldown;
+    std::vector<float> active; // 1 while alive in a running instance, else 0 - masks the per-agent loops
+
+    // Controls, as last applied
+    std::vector<float> move_x, move_y;
+    std::vector<std::uint8_t> act;
+
+    // Bosses, one per instance
+    std::vector<float> boss_x, boss_y;
+    std::vector<float> boss_hp;
+    std::vector<float> boss_attack_timer;
+    std::vector<float> boss_aoe_cycle;
+    std::vector<float> aoe_x, aoe_y;
+    std::vector<float> aoe_timer;
+    std::vector<std::uint32_t> boss_target; // Slot within the party
+    std::vector<std::uint32_t> finish_tick;
+    std::vector<std::uint8_t> done;
+
+    // Every agent, one layer per instance, rebuilt after each step for the proximity sensors.
+    SpatialGrid grid;
+    std::vector<std::uint32_t> agent_instance;
+};
+
+// An EncounterWorld driven by networks, networks[i] playing instance i: each network controls its whole party (the
+// role is one of its inputs). Party members share a topology, so each instance's agents run as one NetworkBatch.
+class EncounterRunner {
+
+  public:
+    explicit EncounterRunner(const EncounterConfig &config);
+
+    // Resets the world for a fresh set of networks (one instance each), keeping its buffers if the count matches.
+    void start(std::vector<neat::Network> networks, neat::Rng &rng);
+
+    // One tick for every running instance. Returns false once they have all finished (or before start()).
+    bool step();
+
+    bool started() const { return world.has_value(); }
+    const EncounterWorld &getWorld() const { return *world; }
+
+    // Activation buffer of party member `slot` in `instance` after the last step(), in the order of the genome's
+    // nodes. Only copies the values; the networks stay where they are. (Parties too wide to batch keep one buffer
+    // per instance, so there it is the last member's.)
+    void copyActivations(std::size_t instance, std::uint32_t slot, std::vector<float> &out) const;
+
+  private:
+    EncounterConfig config;
+    std::optional<EncounterWorld> world;
+    std::vector<neat::Network> networks;
+    std::vector<neat::NetworkBatch> batches; // One per instance, or none if a party is wider than a batch
+    std::vector<float> sensors, controls;
+};
+
+// Plays every network to the end of its encounter (a win, a wipe or config.max_ticks) in one call, and writes
+// fitness[i] = score of instance i. Consumes networks.
+void playEncounters(const EncounterConfig &config, std::vector<neat::Network> &networks, neat::Rng &rng,
+                    float *fitness);
+
+} // namespace sim
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace sim {
+
+enum class SimSpeed { Paused, Normal, Fast, Unbounded };
+
+// Fixed-timestep simulation clock. Real time is fed into an accumulator and drained in whole ticks of
+// tickSeconds(), so the simulation always steps by the same dt no matter how fast frames are drawn.
+class FixedTimestep {
+
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FixedTimestep(double tick_rate_hz = 60.0);
+
+    // Runs however many ticks are owed for `elapsed_seconds` of real time at the current speed.
+    // Unbounded ignores the accumulator and ticks until `deadline`. Returns the number of ticks run.
+    template <typename TickFn> std::uint64_t advance(double elapsed_seconds, Clock::time_point deadline, TickFn &&tick);
+
+    void setSpeed(SimSpeed new_speed);
+    SimSpeed getSpeed() const { return speed; }
+    void setFastMultiplier(double multiplier) { fast_multiplier = multiplier; }
+    double getFastMultiplier() const { return fast_multiplier; }
+
+    double tickSeconds() const { return tick_seconds; }
+    double ticksPerSecond() const { return measured_rate; } // Smoothed, in real time
+
+  private:
+    double speedMultiplier() const;
+    void recordTicks(std::uint64_t ticks, double elapsed_seconds);
+
+    double tick_seconds;
+    double accumulator = 0.0;
+    double fast_multiplier = 10.0;
+    SimSpeed speed = SimSpeed::Normal;
+
+    // Cap on how many ticks a single frame may owe, so a stalled frame can't snowball into a longer one.
+    std::uint64_t max_ticks_per_advance = 1000;
+
+    double measured_rate = 0.0;
+};
+
+template <typename TickFn>
+std::uint64_t FixedTimestep::advance(double elapsed_seconds, Clock::time_point deadline, TickFn &&tick)
+{
+    std::uint64_t ticks = 0;
+
+    if (speed == SimSpeed::Unbounded)
+    {
+        // Check the clock every few ticks rather than every tick; ticks are cheap and now() is not free.
+        do
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                tick();
+            }
+            ticks += 16;
+        } while (Clock::now() < deadline);
+    }
+    else
+    {
+        accumulator += elapsed_seconds * speedMultiplier();
+        while (accumulator >= tick_seconds && ticks < max_ticks_per_advance)
+        {
+            tick();
+            accumulator -= tick_seconds;
+            ++ticks;
+        }
+
+        // Drop whatever is still owed past the cap instead of carrying it into the next frame.
+        if (ticks == max_ticks_per_advance)
+        {
+            accumulator = 0.0;
+        }
+    }
+
+    recordTicks(ticks, elapsed_seconds);
+    return ticks;
+}
+
+} // namespace sim
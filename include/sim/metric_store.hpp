@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sim {
+
+// Range of consecutive samples summarised for plotting.
+struct MetricBucket {
+    std::uint64_t first = 0; // Index of the first sample covered
+    std::uint64_t count = 0; // Samples covered
+    float min = 0.0f;
+    float max = 0.0f;
+};
+
+// One float per sample, kept at several resolutions so any span of history can be drawn with a bounded number of
+// points. Level 0 holds raw samples; each level above merges `fan_out` buckets of the one below into one min/max
+// bucket. Every level is a ring of `level_capacity` buckets, so memory is fixed and the finest levels forget
+// first: recent history stays exact, hours-old history is still there at coarse resolution.
+//
+// min/max (rather than averaging) keeps spikes visible however far the plot is zoomed out.
+class MetricSeries {
+
+  public:
+    static constexpr std::size_t fan_out = 8;
+    static constexpr std::size_t level_count = 8;         // Top level covers fan_out^7 samples a bucket
+    static constexpr std::size_t level_capacity = 4096;   // Buckets per level (power of two)
+
+    MetricSeries();
+
+    void append(float value);
+    std::uint64_t size() const { return total; } // Samples ever appended
+    float latest() const;                         // Newest sample, or 0 before the first
+
+    // Summarises samples [first, last) in at most `max_buckets` buckets (plus one for a partial trailing bucket),
+    // from the finest level that both fits and still holds `first`. Samples older than anything kept are skipped,
+    // so the result may start after `first`. Replaces the contents of `out`.
+    void downsample(std::uint64_t first, std::uint64_t last, std::size_t max_buckets,
+                    std::vector<MetricBucket> &out) const;
+
+  private:
+    struct Range {
+        float min, max;
+    };
+
+    struct Level {
+        std::vector<Range> ring;
+        std::uint64_t completed = 0; // Buckets ever finished at this level
+        Range partial{0.0f, 0.0f};   // Merge of the finished buckets below not yet making up a whole one
+        std::size_t partial_count = 0;
+        std::uint64_t bucket_size = 1; // Samples per bucket
+    };
+
+    std::vector<Level> levels;
+    std::uint64_t total = 0;
+};
+
+// The named series the sim records and the GUI plots. Appends come in batches from the sim thread and queries from
+// the GUI, under one lock; both sides hold it for a bounded amount of work.
+class MetricStore {
+
+  public:
+    explicit MetricStore(std::vector<std::string> names);
+
+    const std::vector<std::string> &getNames() const { return names; }
+    std::size_t seriesCount() const { return names.size(); }
+
+    // `samples` holds whole rows of seriesCount() values, one row per sample.
+    void appendRows(const std::vector<float> &samples);
+
+    std::uint64_t size() const; // Rows appended
+    float latest(std::size_t series) const;
+
+    void downsample(std::size_t series, std::uint64_t first, std::uint64_t last, std::size_t max_buckets,
+                    std::vector<MetricBucket> &out) const;
+
+  private:
+    const std::vector<std::string> names;
+
+    mutable std::mutex mutex;
+    std::vector<MetricSeries> series;
+};
+
+} // namespace sim
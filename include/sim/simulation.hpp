@@ -0,0 +1,67 @@
+#pragma once
+
+#include "neat_core/fitness.hpp"
+#include "neat_core/population.hpp"
+#include "neat_core/thread_pool.hpp"
+#include "sim/encounter.hpp"
+
+#include <cstdint>
+
+namespace sim {
+
+enum class Task { Encounter, Xor };
+
+struct SimulationConfig {
+    Task task = Task::Encounter;
+    EncounterConfig encounter;
+    std::size_t encounter_batch = 16; // Encounter instances stepped together per evaluation job
+    neat::PopulationConfig population; // Inputs/outputs are overridden to fit the task
+    std::size_t threads = 0;                        // Fitness evaluation threads, 0 = one per core
+
+    // Ticks between generations. This only paces the showcase (and how often the GUI sees a new generation): the
+    // evaluation itself runs every episode to completion inside the one tick that breeds, so it scores the same
+    // whatever this is. 30 seconds at 60 Hz lets a showcase encounter play out in real time.
+    std::uint32_t showcase_ticks = 60 * 30;
+
+    // Encounter task only: also play the current generation tick by tick, one instance per genome, so the GUI
+    // has a world to draw. Scoring doesn't use it.
+    bool showcase = false;
+};
+
+// One evolution run, advanced in fixed simulation ticks. Every tick steps the showcase; every showcase_ticks-th
+// tick also scores the whole population and breeds the next generation. That tick blocks for as long as a
+// generation takes (the fitness episodes run to completion on the thread pool) while the others are nearly free,
+// so tick counts and rates describe the showcase, not the evaluation.
+class Simulation {
+
+  public:
+    explicit Simulation(const SimulationConfig &config);
+
+    void tick();
+
+    // Carry on from a checkpoint taken between generations. The showcase starts over on the restored generation.
+    void restore(const neat::CheckpointView &checkpoint);
+
+    std::uint64_t totalTicks() const { return total_ticks; }
+    std::uint32_t showcaseTick() const { return showcase_tick; } // Ticks since the last generation was bred
+    std::uint32_t showcaseTicks() const { return config.showcase_ticks; }
+    const neat::Population &getPopulation() const { return population; }
+
+    // The generation being watched, or null if there is no showcase.
+    const EncounterWorld *showcaseWorld() const { return showcase.started() ? &showcase.getWorld() : nullptr; }
+    const EncounterRunner *showcaseRunner() const { return showcase.started() ? &showcase : nullptr; }
+
+  private:
+    void startShowcase();
+
+    SimulationConfig config;
+    neat::ThreadPool pool;
+    neat::FitnessEvaluator evaluator;
+    neat::Population population;
+    EncounterRunner showcase;
+
+    std::uint64_t total_ticks = 0;
+    std::uint32_t showcase_tick = 0;
+};
+
+} // namespace sim
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "sim/fixed_timestep.hpp"
+#include "sim/metric_store.hpp"
+#include "sim/simulation.hpp"
+#include "sim/triple_buffer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace sim {
+
+// Read-only view of the simulation handed to the GUI. Plain values only, so it can be copied freely.
+struct SimSnapshot {
+    std::uint64_t generation = 0;
+    std::uint64_t total_ticks = 0;
+    std::uint32_t showcase_tick = 0;
+    std::uint32_t showcase_ticks = 0;
+    float best_fitness = 0.0f;
+    std::size_t species_count = 0;
+    double ticks_per_second = 0.0; // Showcase ticks, smoothed
+    SimSpeed speed = SimSpeed::Normal;
+    double fast_multiplier = 0.0;
+};
+
+// What the world view draws, copied out of the showcase encounter after each batch of ticks. Each buffer of the
+// triple buffer keeps its vectors, so publishing stops allocating once the sizes settle.
+struct WorldFrame {
+    std::uint64_t generation = 0;
+    std::uint32_t tick = 0;
+    std::size_t instance_count = 0;
+    std::uint32_t party_size = 0;
+    float arena_half_size = 0.0f;
+    float aoe_radius = 0.0f;
+
+    // Per agent, agent = instance * party_size + slot
+    std::vector<Role> role;
+    std::vector<float> x, y;
+    std::vector<float> heading; // Radians; towards the boss while standing still
+    std::vector<float> health;  // Fraction of max, 0 = dead
+
+    // Per instance
+    std::vector<float> boss_x, boss_y, boss_health;
+    std::vector<float> aoe_x, aoe_y, aoe_timer; // aoe_timer > 0 while a circle is marked
+};
+
+// Genome shown in the Network Viewer, republished only when the generation or the watched genome changes. Nodes are
+// in genome order, which is also the order of the compiled network's activation buffer.
+struct NetworkTopology {
+    std::uint64_t version = 0; // Bumped on every publish, so the viewer rebuilds its layout only when this moves
+    std::uint64_t generation = 0;
+    std::size_t genome = 0;       // Index in the population, and the showcase instance it plays
+    std::size_t genome_count = 0; // Population size, for picking another
+    std::uint32_t num_inputs = 0;
+    std::uint32_t num_outputs = 0;
+
+    std::vector<neat::NodeType> node_types;
+
+    // Per connection, endpoints as node indices
+    std::vector<std::uint32_t> edge_in, edge_out;
+    std::vector<float> edge_weight;
+    std::vector<std::uint8_t> edge_enabled;
+};
+
+// Live activations of one showcase agent: the watched genome's instance, party member `slot`. Only the network's
+// value buffer is copied (one float per node, NetworkTopology order), never the network itself.
+struct ActivationFrame {
+    std::uint64_t generation = 0;
+    std::size_t genome = 0;
+    std::uint32_t tick = 0;
+    std::uint32_t slot = 0;
+    std::vector<Role> party; // Roles of the instance's members, by slot
+    std::vector<float> values;
+};
+
+// Per-tick series recorded from the showcase, by index into SimulationThread::getMetrics().
+enum EncounterMetric : std::size_t {
+    BossHealth,   // Mean fraction of max over the showcase instances
+    PartyHealth,  // Mean fraction of max over every agent
+    TankThreat,   // Share of all threat held by each role, summed over instances
+    HealerThreat,
+    DpsThreat,
+    Reward,       // Mean EncounterWorld::score so far
+    encounter_metric_count
+};
+
+// Runs a Simulation on its own thread, so a slow UI frame never stalls evolution and a heavy generation never
+// drops UI frames. The GUI talks to it only through atomics (controls) and a triple buffer (snapshots).
+class SimulationThread {
+
+  public:
+    explicit SimulationThread(const SimulationConfig &config);
+    ~SimulationThread(); // Stops and joins the worker
+
+    SimulationThread(const SimulationThread &) = delete;
+    SimulationThread &operator=(const SimulationThread &) = delete;
+
+    void start();
+    void stop();
+
+    // Controls - safe to call from any thread, picked up by the worker before its next batch of ticks.
+    void setSpeed(SimSpeed speed) { requested_speed.store(speed, std::memory_order_relaxed); }
+    void setFastMultiplier(double multiplier) { requested_multiplier.store(multiplier, std::memory_order_relaxed); }
+    void watchGenome(std::size_t index) { requested_genome.store(index, std::memory_order_relaxed); }
+    void watchSlot(std::uint32_t slot) { requested_slot.store(slot, std::memory_order_relaxed); }
+
+    // Latest published snapshot. Reader side of the triple buffer, so call from one thread only (the GUI).
+    const SimSnapshot &latestSnapshot();
+
+    // Latest world frame (empty unless the config asked for a showcase). Same single-reader rule.
+    const WorldFrame &latestWorld();
+
+    // Watched genome's topology. Same single-reader rule.
+    const NetworkTopology &latestTopology();
+
+    // Watched agent's activations (empty unless there is a showcase). Same single-reader rule.
+    const ActivationFrame &latestActivations();
+
+    // Encounter metrics, one row per tick while there is a showcase. Safe to query from any thread.
+    const MetricStore &getMetrics() const { return metrics; }
+
+  private:
+    void run();
+    void applyControls();
+    void publishSnapshot();
+    void publishWorld(const EncounterWorld &world);
+    void publishTopology();
+    void publishActivations(const EncounterRunner &runner);
+    void sampleMetrics();
+
+    Simulation simulation;
+    FixedTimestep clock;
+
+    std::thread worker;
+    std::atomic<bool> stop_requested{false};
+    std::atomic<SimSpeed> requested_speed{SimSpeed::Normal};
+    std::atomic<double> requested_multiplier{10.0};
+    std::atomic<std::size_t> requested_genome{0};
+    std::atomic<std::uint32_t> requested_slot{0};
+
+    TripleBuffer<SimSnapshot> snapshots;
+    TripleBuffer<WorldFrame> frames;
+    TripleBuffer<NetworkTopology> topologies;
+    TripleBuffer<ActivationFrame> activations;
+    std::uint64_t topology_version = 0;
+    std::uint64_t topology_generation = ~std::uint64_t(0); // What was last published, sim thread only
+    std::size_t topology_genome = 0;
+
+    MetricStore metrics;
+    std::vector<float> pending_metrics; // Rows sampled since the last publish, sim thread only
+};
+
+} // namespace sim
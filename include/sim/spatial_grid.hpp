@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace sim {
+
+// Uniform grid over a rectangle, rebuilt from scratch every tick. build() counting-sorts the points by cell into
+// one flat array (cell_start[c] .. cell_start[c + 1] are cell c's points), so there are no per-cell allocations
+// and a query only walks the handful of cells it overlaps.
+//
+// The grid can hold several independent layers over the same rectangle - e.g. one per encounter instance - and a
+// query only ever sees points in its own layer.
+class SpatialGrid {
+
+  public:
+    static constexpr std::size_t max_nearest = 16; // Most points one nearest() call returns
+
+    SpatialGrid(float min_x, float min_y, float max_x, float max_y, float cell_size, std::uint32_t layers = 1);
+
+    // Points outside the rectangle are clamped into the edge cells. layers = null puts everything in layer 0.
+    void build(const float *xs, const float *ys, std::size_t count, const std::uint32_t *layers = nullptr);
+
+    // Calls visit(index, distance_squared) for every point of `layer` within `radius` of (x, y).
+    template <typename Visit>
+    void forEachInRadius(std::uint32_t layer, float x, float y, float radius, Visit &&visit) const;
+
+    // Up to k (at most max_nearest) points of `layer` nearest to (x, y) and within max_radius, closest first, for
+    // which accept(index) is true. Returns how many were written to `out`. Searches outwards ring by ring and stops
+    // once no closer cell remains (which assumes the points lie inside the rectangle).
+    template <typename Accept>
+    std::size_t nearest(std::uint32_t layer, float x, float y, std::size_t k, std::uint32_t *out, Accept &&accept,
+                        float max_radius = std::numeric_limits<float>::infinity()) const;
+
+    std::size_t pointCount() const { return sorted_index.size(); }
+    std::uint32_t cellsX() const { return cells_x; }
+    std::uint32_t cellsY() const { return cells_y; }
+
+  private:
+    int cellX(float x) const { return std::clamp(static_cast<int>((x - min_x) * inv_cell), 0, int(cells_x) - 1); }
+    int cellY(float y) const { return std::clamp(static_cast<int>((y - min_y) * inv_cell), 0, int(cells_y) - 1); }
+    std::size_t cellIndex(std::uint32_t layer, int cx, int cy) const
+    {
+        return (std::size_t(layer) * cells_y + cy) * cells_x + cx;
+    }
+
+    float min_x, min_y;
+    float cell_size, inv_cell;
+    std::uint32_t cells_x, cells_y;
+    std::uint32_t layer_count;
+
+    std::vector<std::uint32_t> cell_start;   // cells + 1 entries
+    std::vector<std::uint32_t> point_cell;   // Per input point, scratch for build()
+    std::vector<std::uint32_t> sorted_index; // Original point index, in cell order
+    std::vector<float> sorted_x, sorted_y;   // Positions in cell order, so queries read them sequentially
+};
+
+template <typename Visit>
+void SpatialGrid::forEachInRadius(std::uint32_t layer, float x, float y, float radius, Visit &&visit) const
+{
+
+    const float radius_squared = radius * radius;
+    const int x0 = cellX(x - radius), x1 = cellX(x + radius);
+    const int y0 = cellY(y - radius), y1 = cellY(y + radius);
+
+    for (int cy = y0; cy <= y1; ++cy)
+    {
+        // A row's cells are adjacent, so its points are one contiguous run.
+        const std::uint32_t first = cell_start[cellIndex(layer, x0, cy)];
+        const std::uint32_t last = cell_start[cellIndex(layer, x1, cy) + 1];
+        for (std::uint32_t p = first; p < last; ++p)
+        {
+            const float dx = sorted_x[p] - x;
+            const float dy = sorted_y[p] - y;
+            const float distance_squared = dx * dx + dy * dy;
+            if (distance_squared <= radius_squared)
+            {
+                visit(sorted_index[p], distance_squared);
+            }
+        }
+    }
+}
+
+template <typename Accept>
+std::size_t SpatialGrid::nearest(std::uint32_t layer, float x, float y, std::size_t k, std::uint32_t *out,
+                                 Accept &&accept, float max_radius) const
+{
+
+    k = std::min(k, max_nearest);
+    if (k == 0)
+    {
+        return 0;
+    }
+
+    // Best k so far, kept sorted by insertion - k is small.
+    float best_distance[max_nearest];
+    std::size_t found = 0;
+
+    const float max_squared = max_radius * max_radius;
+    auto consider = [&](std::uint32_t p) {
+        const float dx = sorted_x[p] - x;
+        const float dy = sorted_y[p] - y;
+        const float distance_squared = dx * dx + dy * dy;
+        if (distance_squared > max_squared || (found == k && distance_squared >= best_distance[k - 1]) ||
+            !accept(sorted_index[p]))
+        {
+            return;
+        }
+
+        std::size_t slot = std::min(found, k - 1);
+        found = std::min(found + 1, k);
+        for (; slot > 0 && best_distance[slot - 1] > distance_squared; --slot)
+        {
+            best_distance[slot] = best_distance[slot - 1];
+            out[slot] = out[slot - 1];
+        }
+        best_distance[slot] = distance_squared;
+        out[slot] = sorted_index[p];
+    };
+
+    const int cx = cellX(x), cy = cellY(y);
+    const int max_ring = std::max({cx, int(cells_x) - 1 - cx, cy, int(cells_y) - 1 - cy});
+
+    for (int ring = 0; ring <= max_ring; ++ring)
+    {
+        // Anything in this ring is at least (ring - 1) cells away.
+        const float reach = std::max(0, ring - 1) * cell_size;
+        if (reach * reach > max_squared || (found == k && reach * reach >= best_distance[k - 1]))
+        {
+            break;
+        }
+
+        for (int gy = cy - ring; gy <= cy + ring; ++gy)
+        {
+            if (gy < 0 || gy >= int(cells_y))
+            {
+                continue;
+            }
+
+            // Whole row on the top and bottom edges of the ring, just the two ends elsewhere.
+            const bool edge_row = gy == cy - ring || gy == cy + ring;
+            const int step = edge_row ? 1 : std::max(1, 2 * ring);
+            for (int gx = cx - ring; gx <= cx + ring; gx += step)
+            {
+                if (gx < 0 || gx >= int(cells_x))
+                {
+                    continue;
+                }
+
+                const std::size_t cell = cellIndex(layer, gx, gy);
+                for (std::uint32_t p = cell_start[cell]; p < cell_start[cell + 1]; ++p)
+                {
+                    consider(p);
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+} // namespace sim
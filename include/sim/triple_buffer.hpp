@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+
+namespace sim {
+
+// Lock-free single-producer / single-consumer triple buffer.
+// The writer fills writeBuffer() and publish()es it; the reader calls update() and then reads readBuffer().
+// Neither side ever waits on the other: the writer always has a private buffer to fill, the reader always has
+// a complete one to look at, and the third slot is swapped between them with a single atomic exchange.
+template <typename T> class TripleBuffer {
+
+  public:
+    // Writer side
+    T &writeBuffer() { return slots[back].value; }
+    void publish() { back = middle.exchange(back | fresh_bit, std::memory_order_acq_rel) & index_mask; }
+
+    // Reader side. Returns true if a newer value was picked up since the last call.
+    bool update()
+    {
+        if ((middle.load(std::memory_order_relaxed) & fresh_bit) == 0)
+        {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & index_mask;
+        return true;
+    }
+    const T &readBuffer() const { return slots[front].value; }
+
+  private:
+    static constexpr unsigned index_mask = 0x3;
+    static constexpr unsigned fresh_bit = 0x4; // Set in `middle` when it holds something the reader hasn't seen
+
+    // Each slot on its own cache line so the writer filling one doesn't bounce the reader's line.
+    struct alignas(64) Slot {
+        T value{};
+    };
+
+    Slot slots[3];
+    unsigned back = 0;  // Owned by the writer
+    unsigned front = 1; // Owned by the reader
+    std::atomic<unsigned> middle{2};
+};
+
+} // namespace sim
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "glad/gl.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One textured quad. Fed to the GPU as per-instance data; the quad's corners are made up in the vertex shader.
+struct Sprite {
+    float x, y;          // Centre, world units
+    float width, height; // World units
+    float rotation;      // Radians, counter-clockwise
+    float u0, v0, u1, v1;
+    std::uint32_t color; // RGBA8 tint (R in the low byte), multiplied with the texel
+};
+
+// Collects sprites into layers each frame and draws every layer with one instanced draw call, back to front.
+// All layers share a single streaming VBO that is orphaned and refilled once per draw(), so the driver never
+// stalls waiting for the GPU to finish with last frame's copy. OpenGL 3.3.
+class SpriteBatch {
+
+  public:
+    explicit SpriteBatch(std::size_t layer_count);
+
+    void init(); // Needs a current GL context
+    void shutdown();
+
+    void clear();
+    void add(std::size_t layer, const Sprite &sprite) { layers[layer].push_back(sprite); }
+    std::vector<Sprite> &layer(std::size_t index) { return layers[index]; }
+
+    // view = (scale x, scale y, offset x, offset y): clip position = world * scale + offset. Draws into whatever
+    // framebuffer and viewport are bound.
+    void draw(GLuint texture, const float view[4]);
+
+    // For static geometry kept in a caller-owned VBO (tightly packed Sprites): bind() sets up the shader, texture
+    // and view, then each drawBuffer() is one instanced draw. Not counted in drawCalls().
+    void bind(GLuint texture, const float view[4]);
+    void drawBuffer(GLuint buffer, std::size_t count);
+
+    std::size_t spriteCount() const;
+    std::size_t drawCalls() const { return draw_calls; } // In the last draw()
+
+    static std::uint32_t rgba(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255)
+    {
+        return r | (g << 8) | (b << 16) | (std::uint32_t(a) << 24);
+    }
+
+  private:
+    void pointAttributes(std::size_t first_sprite);
+
+    std::vector<std::vector<Sprite>> layers;
+    std::size_t draw_calls = 0;
+
+    GLuint program = 0;
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLint view_location = -1;
+    GLint texture_location = -1;
+    std::size_t capacity = 0; // Sprites the VBO has room for
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "glad/gl.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Several images packed into one GL texture, so sprites using any of them can go out in the same draw call.
+class TextureAtlas {
+
+  public:
+    struct Region {
+        float u0, v0, u1, v1; // v0 is the image's top row
+    };
+
+    TextureAtlas() = default;
+
+    TextureAtlas(const TextureAtlas &) = delete;
+    TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+    // Loads directory/<name>.png for each name, packs them and uploads the result; region(i) is names[i]. Images
+    // bigger than max_image_size on a side are box-filtered down first. Throws std::runtime_error if a file can't
+    // be read or the images don't fit in a texture. Needs a current GL context.
+    void load(const std::string &directory, const std::vector<std::string> &names, int max_image_size = 64);
+    void shutdown(); // Frees the texture; call while the GL context is still current
+
+    const Region &region(std::size_t index) const { return regions[index]; }
+    const Region &whiteRegion() const { return white; } // Solid white texels, for flat-coloured quads
+    GLuint texture() const { return texture_id; }
+    int width() const { return atlas_width; }
+    int height() const { return atlas_height; }
+
+  private:
+    struct Image {
+        int width = 0, height = 0;
+        std::vector<std::uint8_t> rgba;
+    };
+
+    static Image readPng(const std::string &path);
+    static Image shrink(const Image &image, int max_size);
+
+    std::vector<Region> regions;
+    Region white{};
+    GLuint texture_id = 0;
+    int atlas_width = 0, atlas_height = 0;
+};
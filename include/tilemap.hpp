@@ -0,0 +1,61 @@
+#pragma once
+
+#include "sprite_batch.hpp"
+#include "texture_atlas.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Terrain: a grid of tile ids split into chunk_tiles x chunk_tiles chunks. Each chunk keeps its sprites in its own
+// static VBO, built the first time it is seen and rebuilt only after one of its tiles changes, so a frame with no
+// edits uploads nothing. Chunks outside the view are skipped entirely.
+class Tilemap {
+
+  public:
+    static constexpr int chunk_tiles = 16;
+    static constexpr std::uint8_t empty = 0; // Tile id that draws nothing
+
+    void shutdown(); // Frees the chunk buffers; call while the GL context is still current
+
+    // Clears the map to `empty`. Tile (x, y) is centred at (origin_x + x * tile_size, origin_y - y * tile_size), so
+    // rows run top to bottom.
+    void reset(int width, int height, float tile_size, float origin_x, float origin_y);
+
+    // Texture for a tile id. Changing it rebuilds every chunk.
+    void setTileRegion(std::uint8_t tile, const TextureAtlas::Region &region);
+
+    void setTile(int x, int y, std::uint8_t tile);
+    std::uint8_t tile(int x, int y) const { return tiles[std::size_t(y) * width + x]; }
+
+    // Draws the chunks overlapping the world rectangle [min_x, max_x] x [min_y, max_y] with batch's shader,
+    // uploading any of them that are dirty first. batch.bind() must have been called.
+    void draw(SpriteBatch &batch, float min_x, float min_y, float max_x, float max_y);
+
+    int tilesX() const { return width; }
+    int tilesY() const { return height; }
+    std::size_t chunksDrawn() const { return chunks_drawn; }     // In the last draw()
+    std::size_t chunksUploaded() const { return chunks_uploaded; } // In the last draw()
+
+  private:
+    struct Chunk {
+        GLuint vbo = 0;
+        std::size_t sprite_count = 0;
+        bool dirty = true;
+    };
+
+    void rebuild(int chunk_x, int chunk_y, Chunk &chunk);
+
+    int width = 0, height = 0;
+    int chunks_x = 0, chunks_y = 0;
+    float tile_size = 1.0f;
+    float origin_x = 0.0f, origin_y = 0.0f;
+
+    std::vector<std::uint8_t> tiles;
+    std::vector<Chunk> chunks;
+    std::vector<TextureAtlas::Region> regions; // By tile id
+    std::vector<Sprite> scratch;               // Reused while building a chunk
+
+    std::size_t chunks_drawn = 0;
+    std::size_t chunks_uploaded = 0;
+};
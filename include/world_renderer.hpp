@@ -0,0 +1,59 @@
+#pragma once
+
+#include "sprite_batch.hpp"
+#include "texture_atlas.hpp"
+#include "tilemap.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace sim {
+struct WorldFrame;
+} // namespace sim
+
+// Draws the showcase encounters from a sim::WorldFrame. Every instance gets its own arena, laid out in a grid, and
+// everything goes through one SpriteBatch: a frame costs one draw call per layer however many agents there are.
+class WorldRenderer {
+
+  public:
+    WorldRenderer();
+
+    // Loads the sprites from texture_dir. Needs a current GL context; throws std::runtime_error on failure.
+    void init(const std::string &texture_dir);
+    void shutdown();
+
+    // Draws the whole grid of arenas, fitted to a width x height viewport, into the bound framebuffer.
+    void render(const sim::WorldFrame &frame, int width, int height);
+
+    std::size_t spriteCount() const { return sprite_count; } // In the last render()
+    std::size_t drawCalls() const { return batch.drawCalls() + terrain.chunksDrawn(); }
+    const Tilemap &getTerrain() const { return terrain; }
+
+  private:
+    enum Layer : std::size_t { Markers, Units, Bars, layer_count };
+
+    // Arenas sit in a grid of columns x rows, tiles x tiles ground tiles each, one empty tile apart.
+    struct Layout {
+        std::size_t columns = 0, rows = 0;
+        int tiles = 0;
+        float tile_size = 0.0f;
+        float pitch = 0.0f; // Arena centre to arena centre
+    };
+
+    static Layout layoutFor(const sim::WorldFrame &frame);
+    void arenaCentre(std::size_t instance, float &x, float &y) const;
+
+    // Lays the terrain out again when the number or size of arenas changed; otherwise its chunks stay cached.
+    void updateTerrain(const sim::WorldFrame &frame);
+    void addEncounters(const sim::WorldFrame &frame);
+    void addBar(float x, float y, float width, float fraction, std::uint32_t color);
+
+    TextureAtlas atlas;
+    SpriteBatch batch;
+    Tilemap terrain;
+    Layout layout;
+    std::size_t terrain_instances = 0;
+    float terrain_half_size = 0.0f;
+    std::size_t sprite_count = 0;
+};
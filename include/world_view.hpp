@@ -0,0 +1,57 @@
+#pragma once
+
+#include "glad/gl.h"
+#include "world_renderer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace sim {
+struct WorldFrame;
+} // namespace sim
+
+// The world drawn off-screen for the "World" window: WorldRenderer output goes into a framebuffer texture that
+// ImGui shows as an image. The world can run at a fraction of the window's resolution and at a lower rate than the
+// UI, so watching a run costs a bounded amount of GPU/CPU time. Nothing is drawn while the window is hidden or
+// the sim hasn't moved.
+class WorldView {
+
+  public:
+    void init(const std::string &texture_dir); // Needs a current GL context; throws std::runtime_error on failure
+    void shutdown();
+
+    // Called by the window each UI frame it is visible, with its content size in pixels.
+    void requestFrame(int width, int height);
+
+    // Redraws into the framebuffer if the window asked for a frame and one is due. Leaves the default framebuffer
+    // bound.
+    void render(const sim::WorldFrame &frame);
+
+    GLuint texture() const { return color_texture; }
+    int textureWidth() const { return target_width; }
+    int textureHeight() const { return target_height; }
+    const WorldRenderer &getRenderer() const { return renderer; }
+
+    // Options, shown in the window
+    float resolution_scale = 1.0f; // Framebuffer size relative to the window, (0, 1]
+    float max_fps = 30.0f;         // World redraws per second at most, 0 = every UI frame
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    void resizeTarget(int width, int height);
+
+    WorldRenderer renderer;
+
+    GLuint framebuffer = 0;
+    GLuint color_texture = 0;
+    int target_width = 0, target_height = 0;
+
+    int requested_width = 0, requested_height = 0;
+    bool requested = false;
+
+    Clock::time_point last_render{};
+    std::uint64_t last_generation = ~std::uint64_t(0);
+    std::uint32_t last_tick = 0;
+};
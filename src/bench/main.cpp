@@ -0,0 +1,582 @@
+// Benchmarks for the neat_core hot paths (neat_bench). A small in-tree harness rather than Google Benchmark, so it
+// builds anywhere neat_core does. Every case is timed over several repetitions of at least --min-time seconds each
+// and the median time per item is reported; --json also writes the results out for comparing between commits.
+
+#include "neat_core/arena.hpp"
+#include "neat_core/batch_network.hpp"
+#include "neat_core/fitness.hpp"
+#include "neat_core/genome.hpp"
+#include "neat_core/innovation.hpp"
+#include "neat_core/network.hpp"
+#include "neat_core/population.hpp"
+#include "neat_core/rng.hpp"
+#include "neat_core/thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct BenchOptions {
+    double min_time = 0.2; // Seconds per repetition
+    int repetitions = 5;
+    std::string filter; // Only run cases whose name contains this
+    std::string json_path;
+};
+
+using Params = std::vector<std::pair<std::string, std::uint64_t>>;
+
+struct BenchResult {
+    std::string group; // e.g. "distance"
+    Params params;     // e.g. {"connections", 120}
+    std::uint64_t iterations = 0; // Per repetition
+    std::uint64_t items = 0;      // Per repetition
+    double median_ns = 0.0;       // Per item, as are the rest
+    double min_ns = 0.0;
+    double max_ns = 0.0;
+    double mean_ns = 0.0;
+
+    std::string name() const
+    {
+
+        std::string name = group;
+        for (const auto &param : params)
+        {
+            name += "/" + param.first + ":" + std::to_string(param.second);
+        }
+        return name;
+    }
+};
+
+// Keeps the compiler from optimising away work whose result is otherwise unused.
+template <class T> void keep(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void *volatile sink;
+    sink = &value;
+#endif
+}
+
+class Bench {
+
+  public:
+    explicit Bench(const BenchOptions &options) : options(options) {}
+
+    // body(iterations) does `iterations` rounds of work and returns how many items that covered (genomes,
+    // networks, ...), so batched and single cases report comparable per-item times.
+    void run(const std::string &group, const Params &params, const std::function<std::uint64_t(std::uint64_t)> &body)
+    {
+
+        BenchResult result;
+        result.group = group;
+        result.params = params;
+        if (!selected(result.name()))
+        {
+            return;
+        }
+
+        // Grow the iteration count until one repetition takes at least min_time.
+        std::uint64_t iterations = 1;
+        while (true)
+        {
+            const double seconds = time(body, iterations).first;
+            if (seconds >= options.min_time || iterations >= (std::uint64_t(1) << 40))
+            {
+                break;
+            }
+            const double scale = seconds > 0.0 ? options.min_time / seconds * 1.2 : 10.0;
+            iterations = static_cast<std::uint64_t>(iterations * std::min(10.0, std::max(2.0, scale)));
+        }
+
+        std::vector<double> per_item;
+        for (int r = 0; r < options.repetitions; ++r)
+        {
+            const auto timing = time(body, iterations);
+            result.items = timing.second;
+            per_item.push_back(timing.first * 1e9 / std::max<std::uint64_t>(1, timing.second));
+        }
+
+        std::sort(per_item.begin(), per_item.end());
+        result.iterations = iterations;
+        result.median_ns = per_item[per_item.size() / 2];
+        result.min_ns = per_item.front();
+        result.max_ns = per_item.back();
+        for (double ns : per_item)
+        {
+            result.mean_ns += ns / per_item.size();
+        }
+
+        std::cout << std::left << std::setw(44) << result.name() << std::right << std::setw(14) << std::fixed
+                  << std::setprecision(1) << result.median_ns << " ns" << std::setw(14) << result.min_ns << " ns"
+                  << std::setw(16) << std::setprecision(0) << 1e9 / result.median_ns << " /s" << std::endl;
+
+        results.push_back(std::move(result));
+    }
+
+    // Lets cases with expensive setup skip it when --filter rules them out.
+    bool selected(const std::string &name) const
+    {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    }
+
+    const std::vector<BenchResult> &getResults() const { return results; }
+
+  private:
+    static std::pair<double, std::uint64_t> time(const std::function<std::uint64_t(std::uint64_t)> &body,
+                                                 std::uint64_t iterations)
+    {
+
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint64_t items = body(iterations);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return {seconds, items};
+    }
+
+    BenchOptions options;
+    std::vector<BenchResult> results;
+};
+
+// -------------------------------------------------------------------------------------------------------------
+// Fixtures
+// -------------------------------------------------------------------------------------------------------------
+
+constexpr std::uint32_t bench_inputs = 8;
+constexpr std::uint32_t bench_outputs = 4;
+constexpr std::size_t fixture_count = 64; // Distinct genomes per size, so one lucky shape doesn't decide a case
+
+const std::uint32_t genome_sizes[] = {40, 120, 400}; // Connections; 36 is the minimal 8-in 4-out genome
+const std::size_t population_sizes[] = {150, 1000, 5000};
+
+// A minimal genome grown by structural mutations until it has at least `connections` genes.
+neat::Genome grownGenome(std::uint32_t connections, neat::Rng &rng, neat::InnovationRegistry &registry,
+                         const neat::MutationConfig &config)
+{
+
+    neat::Genome genome = neat::Genome::minimal(bench_inputs, bench_outputs, rng, config);
+    while (genome.connectionCount() < connections)
+    {
+        if (neat::randomChance(rng, 0.3f))
+        {
+            genome.mutateAddNode(rng, registry);
+        }
+        else
+        {
+            genome.mutateAddConnection(rng, registry, config);
+        }
+    }
+    return genome;
+}
+
+struct GenomeFixture {
+    neat::InnovationRegistry registry{neat::Genome::minimalNodeCount(bench_inputs, bench_outputs),
+                                      neat::Genome::minimalInnovationCount(bench_inputs, bench_outputs)};
+    std::vector<neat::Genome> genomes;
+    std::vector<neat::Genome> relatives; // relatives[i] is a mutated copy of genomes[i]
+    std::vector<neat::Network> networks;
+};
+
+void buildFixture(GenomeFixture &fixture, std::uint32_t connections, neat::Rng &rng, const neat::MutationConfig &config)
+{
+
+    for (std::size_t i = 0; i < fixture_count; ++i)
+    {
+        fixture.genomes.push_back(grownGenome(connections, rng, fixture.registry, config));
+
+        neat::Genome relative = fixture.genomes.back();
+        relative.mutate(rng, fixture.registry, config);
+        fixture.relatives.push_back(std::move(relative));
+
+        fixture.networks.push_back(neat::Network::compile(fixture.genomes.back()));
+    }
+}
+
+// -------------------------------------------------------------------------------------------------------------
+// Cases
+// -------------------------------------------------------------------------------------------------------------
+
+void benchGenomes(Bench &bench, std::uint32_t connections)
+{
+
+    neat::Rng rng(connections);
+    const neat::MutationConfig mutation;
+    const neat::CompatibilityConfig compatibility;
+
+    GenomeFixture fixture;
+    buildFixture(fixture, connections, rng, mutation);
+    const Params params = {{"connections", connections}};
+
+    // Children go into an arena like they do in Population, reset every so often to keep memory flat.
+    neat::Arena arena;
+
+    bench.run("mutate", params, [&](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            {
+                neat::Genome child(fixture.genomes[i % fixture_count], &arena);
+                child.mutate(rng, fixture.registry, mutation);
+                keep(child);
+            }
+            if (i % 1024 == 1023)
+            {
+                arena.reset();
+                fixture.registry.newGeneration();
+            }
+        }
+        arena.reset();
+        return iterations;
+    });
+
+    bench.run("crossover", params, [&](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            {
+                const std::size_t f = i % fixture_count;
+                neat::Genome child =
+                    neat::Genome::crossover(fixture.genomes[f], fixture.relatives[f], rng, mutation, &arena);
+                keep(child);
+            }
+            if (i % 1024 == 1023)
+            {
+                arena.reset();
+            }
+        }
+        arena.reset();
+        return iterations;
+    });
+
+    // Unrelated pairs (grown separately) - the usual case when a genome is checked against foreign species.
+    bench.run("distance", params, [&](std::uint64_t iterations) {
+        float total = 0.0f;
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            const std::size_t f = i % fixture_count;
+            total += neat::Genome::compatibilityDistance(fixture.genomes[f], fixture.genomes[(f + 1) % fixture_count],
+                                                         compatibility);
+        }
+        keep(total);
+        return iterations;
+    });
+
+    // Same pairs with the speciation threshold as the limit, as Population uses it.
+    bench.run("distance_limited", params, [&](std::uint64_t iterations) {
+        float total = 0.0f;
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            const std::size_t f = i % fixture_count;
+            total += neat::Genome::compatibilityDistance(fixture.genomes[f], fixture.genomes[(f + 1) % fixture_count],
+                                                         compatibility, compatibility.threshold);
+        }
+        keep(total);
+        return iterations;
+    });
+
+    bench.run("compile", params, [&](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            neat::Network network = neat::Network::compile(fixture.genomes[i % fixture_count]);
+            keep(network);
+        }
+        return iterations;
+    });
+
+    float inputs[bench_inputs * neat::NetworkBatch::lanes];
+    float outputs[bench_outputs * neat::NetworkBatch::lanes];
+    for (std::size_t i = 0; i < bench_inputs * neat::NetworkBatch::lanes; ++i)
+    {
+        inputs[i] = neat::randomFloat(rng, -1.0f, 1.0f);
+    }
+
+    bench.run("activate", params, [&](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            fixture.networks[i % fixture_count].activate(inputs, outputs);
+            keep(outputs);
+        }
+        return iterations;
+    });
+
+    // One full batch: the same topology with different weights in every lane.
+    std::vector<neat::Network> lanes;
+    for (std::size_t lane = 0; lane < neat::NetworkBatch::lanes; ++lane)
+    {
+        neat::Genome variant = fixture.genomes[0];
+        variant.mutateWeights(rng, mutation);
+        lanes.push_back(neat::Network::compile(variant));
+    }
+    std::vector<const neat::Network *> lane_pointers;
+    for (const neat::Network &network : lanes)
+    {
+        lane_pointers.push_back(&network);
+    }
+    neat::NetworkBatch batch(lane_pointers.data(), lane_pointers.size());
+
+    bench.run("activate_batch", params, [&](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            batch.activate(inputs, outputs);
+            keep(outputs);
+        }
+        return iterations * batch.laneCount();
+    });
+}
+
+void benchPopulation(Bench &bench, neat::ThreadPool &pool, std::size_t size)
+{
+
+    const std::string population = "/population:" + std::to_string(size);
+    if (!bench.selected("speciate" + population) && !bench.selected("epoch" + population) &&
+        !bench.selected("activate_generation" + population) && !bench.selected("group_generation" + population))
+    {
+        return;
+    }
+
+    neat::PopulationConfig config;
+    config.size = size;
+    config.num_inputs = 2;
+    config.num_outputs = 1;
+
+    // A few generations of XOR first, so there's structure and more than one species to sort into.
+    neat::FitnessEvaluator evaluator(pool, neat::xorEpisode);
+    neat::Population serial(config);
+    neat::Population parallel(config, &pool);
+    for (int generation = 0; generation < 20; ++generation)
+    {
+        serial.epoch(evaluator);
+        parallel.epoch(evaluator);
+    }
+
+    bench.run("speciate", {{"population", size}, {"threads", 1}}, [&](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            serial.respeciate();
+        }
+        return iterations * size;
+    });
+
+    if (pool.threadCount() > 1)
+    {
+        bench.run("speciate", {{"population", size}, {"threads", pool.threadCount()}}, [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i)
+            {
+                parallel.respeciate();
+            }
+            return iterations * size;
+        });
+    }
+
+    // An evolved generation's phenotypes stepped once each: one network at a time, then grouped by topology so
+    // same-shaped networks share lane-parallel sweeps. Grouping is timed on its own, since it only pays off when
+    // the groups are kept for many steps (a long episode), not rebuilt for a handful.
+    std::vector<neat::Network> networks;
+    for (const neat::Genome &genome : parallel.getGenomes())
+    {
+        networks.push_back(neat::Network::compile(genome));
+    }
+    std::vector<float> step_inputs(networks.size() * config.num_inputs);
+    std::vector<float> step_outputs(networks.size() * config.num_outputs);
+    neat::Rng rng(size);
+    for (float &input : step_inputs)
+    {
+        input = neat::randomFloat(rng, -1.0f, 1.0f);
+    }
+
+    bench.run("activate_generation", {{"population", size}, {"grouped", 0}}, [&](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            for (std::size_t n = 0; n < networks.size(); ++n)
+            {
+                networks[n].activate(&step_inputs[n * config.num_inputs], &step_outputs[n * config.num_outputs]);
+            }
+            keep(step_outputs);
+        }
+        return iterations * size;
+    });
+
+    neat::BatchedNetworks grouped(networks);
+    bench.run("activate_generation", {{"population", size}, {"grouped", 1}}, [&](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            grouped.activate(step_inputs.data(), step_outputs.data());
+            keep(step_outputs);
+        }
+        return iterations * size;
+    });
+
+    bench.run("group_generation", {{"population", size}}, [&](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            neat::BatchedNetworks regrouped(networks);
+            keep(regrouped);
+        }
+        return iterations * size;
+    });
+
+    // The whole loop: compile and score every genome, breed, speciate.
+    bench.run("epoch", {{"population", size}, {"threads", pool.threadCount()}}, [&](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            parallel.epoch(evaluator);
+        }
+        return iterations * size;
+    });
+}
+
+// -------------------------------------------------------------------------------------------------------------
+// Output
+// -------------------------------------------------------------------------------------------------------------
+
+bool writeJson(const std::vector<BenchResult> &results, const BenchOptions &options, std::size_t threads,
+               const std::string &path)
+{
+
+    std::ofstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#ifdef NDEBUG
+    const bool assertions = false;
+#else
+    const bool assertions = true;
+#endif
+
+#if defined(__clang__)
+    const std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    const std::string compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    const std::string compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    const std::string compiler = "unknown";
+#endif
+
+    file << std::setprecision(6) << std::fixed;
+    file << "{\n";
+    file << "  \"context\": {\n";
+    file << "    \"date\": \"" << date << "\",\n";
+    file << "    \"compiler\": \"" << compiler << "\",\n";
+    file << "    \"assertions\": " << (assertions ? "true" : "false") << ",\n";
+    file << "    \"threads\": " << threads << ",\n";
+    file << "    \"batch_lanes\": " << neat::NetworkBatch::lanes << ",\n";
+    file << "    \"min_time\": " << options.min_time << ",\n";
+    file << "    \"repetitions\": " << options.repetitions << "\n";
+    file << "  },\n";
+    file << "  \"benchmarks\": [\n";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchResult &r = results[i];
+        file << "    {\"name\": \"" << r.name() << "\", \"group\": \"" << r.group << "\", \"params\": {";
+        for (std::size_t p = 0; p < r.params.size(); ++p)
+        {
+            file << (p ? ", " : "") << "\"" << r.params[p].first << "\": " << r.params[p].second;
+        }
+        file << "}, \"iterations\": " << r.iterations << ", \"items\": " << r.items
+             << ", \"median_ns\": " << r.median_ns << ", \"min_ns\": " << r.min_ns << ", \"max_ns\": " << r.max_ns
+             << ", \"mean_ns\": " << r.mean_ns << ", \"items_per_second\": " << 1e9 / r.median_ns << "}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    file << "  ]\n";
+    file << "}\n";
+    return static_cast<bool>(file);
+}
+
+void printUsage(const char *exe)
+{
+
+    std::cout << "Usage: " << exe << " [options]\n"
+              << "  --filter TEXT     Only run cases whose name contains TEXT (e.g. distance, population:1000)\n"
+              << "  --min-time S      Seconds per repetition (default: 0.2)\n"
+              << "  --repetitions N   Timed repetitions per case; the median is reported (default: 5)\n"
+              << "  --threads N       Threads for the parallel cases (default: one per core)\n"
+              << "  --json PATH       Also write the results to PATH as JSON\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+
+    BenchOptions options;
+    std::size_t threads = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        if (std::strcmp(arg, "--filter") == 0 && has_value)
+        {
+            options.filter = argv[++i];
+        }
+        else if (std::strcmp(arg, "--min-time") == 0 && has_value)
+        {
+            options.min_time = std::strtod(argv[++i], nullptr);
+        }
+        else if (std::strcmp(arg, "--repetitions") == 0 && has_value)
+        {
+            options.repetitions = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(arg, "--threads") == 0 && has_value)
+        {
+            threads = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--json") == 0 && has_value)
+        {
+            options.json_path = argv[++i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0 ? 0 : 1;
+        }
+    }
+
+#ifndef NDEBUG
+    std::cerr << "Warning: assertions are on - configure with -DCMAKE_BUILD_TYPE=Release for meaningful numbers"
+              << std::endl;
+#endif
+
+    neat::ThreadPool pool(threads);
+    Bench bench(options);
+
+    std::cout << std::left << std::setw(44) << "case" << std::right << std::setw(17) << "median/item"
+              << std::setw(17) << "min/item" << std::setw(19) << "items/s" << std::endl;
+
+    for (std::uint32_t connections : genome_sizes)
+    {
+        benchGenomes(bench, connections);
+    }
+    for (std::size_t size : population_sizes)
+    {
+        benchPopulation(bench, pool, size);
+    }
+
+    if (!options.json_path.empty() && !writeJson(bench.getResults(), options, pool.threadCount(), options.json_path))
+    {
+        std::cerr << "Couldn't write " << options.json_path << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
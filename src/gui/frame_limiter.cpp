@@ -0,0 +1,30 @@
+#include "frame_limiter.hpp"
+
+#include <thread>
+
+FrameLimiter::FrameLimiter(double target_fps) : next_frame(Clock::now())
+{
+    setTargetFps(target_fps);
+}
+
+void FrameLimiter::setTargetFps(double fps)
+{
+
+    target_fps = fps;
+    frame_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+    next_frame = Clock::now() + frame_period;
+}
+
+void FrameLimiter::wait()
+{
+
+    std::this_thread::sleep_until(next_frame);
+
+    // If we fell more than a frame behind, resync instead of rendering a burst of frames to catch up.
+    const auto now = Clock::now();
+    next_frame += frame_period;
+    if (next_frame < now)
+    {
+        next_frame = now + frame_period;
+    }
+}
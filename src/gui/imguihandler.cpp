@@ -4,6 +4,8 @@
 #include "imgui_impl_opengl3.h"
 #include "imgui_impl_sdl2.h"
 #include "imgui_internal.h"
+#include "sim/simulation_thread.hpp"
+#include "world_view.hpp"
 
 void ImGuiHandler::Init(SDL_Window* window, SDL_GLContext gl_ctx, const char* glsl_version)
 {
@@ -44,16 +46,112 @@ void ImGuiHandler::Update(bool first_update)
         initDefaultLayout();
     }
 
-    ImGui::Begin("Control Panel");
-    ImGui::Text("Run/pause, mutation rate, etc.");
-    ImGui::End();
+    drawControlPanel();
+    drawWorldWindow();
+    profiler_window.draw();
+
+    metrics_window.draw(sim_thread);
+
+    network_viewer.draw(sim_thread);
+}
+
+void ImGuiHandler::setSimulation(sim::SimulationThread* sim_thread)
+{
+    this->sim_thread = sim_thread;
+}
+
+void ImGuiHandler::setWorldView(WorldView* world_view)
+{
+    this->world_view = world_view;
+}
+
+void ImGuiHandler::drawWorldWindow()
+{
+
+    // Begin() returns false while the window is collapsed or a hidden tab; then no frame is requested and the
+    // world isn't drawn at all.
+    if (!ImGui::Begin("World") || !world_view)
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Resolution", &world_view->resolution_scale, 0.25f, 1.0f, "%.2fx");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Max FPS", &world_view->max_fps, 0.0f, 120.0f, world_view->max_fps > 0.0f ? "%.0f" : "UI rate");
+    ImGui::SameLine();
+    const WorldRenderer& renderer = world_view->getRenderer();
+    ImGui::Text("%dx%d, %zu sprites, %zu draws", world_view->textureWidth(), world_view->textureHeight(),
+                renderer.spriteCount(), renderer.drawCalls());
+
+    const ImVec2 size = ImGui::GetContentRegionAvail();
+    if (size.x >= 1.0f && size.y >= 1.0f)
+    {
+        world_view->requestFrame(static_cast<int>(size.x), static_cast<int>(size.y));
+
+        // GL textures start at the bottom row, so flip V.
+        if (world_view->texture() != 0)
+        {
+            ImGui::Image(static_cast<ImTextureID>(world_view->texture()), size, ImVec2(0, 1), ImVec2(1, 0));
+        }
+    }
 
-    ImGui::Begin("Crypto Chart");
-    ImGui::Text("Insert ImPlot or graphs here.");
     ImGui::End();
+}
+
+void ImGuiHandler::drawControlPanel()
+{
+
+    ImGui::Begin("Control Panel");
+
+    if (!sim_thread)
+    {
+        ImGui::Text("No simulation attached.");
+        ImGui::End();
+        return;
+    }
+
+    // Read-only snapshot published by the sim thread; never blocks on it.
+    const sim::SimSnapshot& snapshot = sim_thread->latestSnapshot();
+
+    // Fast-forward controls. The sim ticks on its own thread and timestep, so none of these change the UI frame rate.
+    sim::SimSpeed speed = snapshot.speed;
+    const sim::SimSpeed before = speed;
+
+    if (ImGui::RadioButton("Pause", speed == sim::SimSpeed::Paused))
+        speed = sim::SimSpeed::Paused;
+    ImGui::SameLine();
+    if (ImGui::RadioButton("1x", speed == sim::SimSpeed::Normal))
+        speed = sim::SimSpeed::Normal;
+    ImGui::SameLine();
+    if (ImGui::RadioButton("Fast", speed == sim::SimSpeed::Fast))
+        speed = sim::SimSpeed::Fast;
+    ImGui::SameLine();
+    if (ImGui::RadioButton("Unbounded", speed == sim::SimSpeed::Unbounded))
+        speed = sim::SimSpeed::Unbounded;
+
+    if (speed != before)
+    {
+        sim_thread->setSpeed(speed);
+    }
+
+    float multiplier = static_cast<float>(snapshot.fast_multiplier);
+    if (ImGui::SliderFloat("Fast multiplier", &multiplier, 2.0f, 100.0f, "%.0fx"))
+    {
+        sim_thread->setFastMultiplier(multiplier);
+    }
+
+    ImGui::Separator();
+
+    ImGui::Text("Generation: %llu", static_cast<unsigned long long>(snapshot.generation));
+    ImGui::Text("Showcase tick: %u / %u", snapshot.showcase_tick, snapshot.showcase_ticks);
+    ImGui::Text("Best fitness: %.3f", snapshot.best_fitness);
+    ImGui::Text("Species: %zu", snapshot.species_count);
+    ImGui::Text("Showcase rate: %.0f ticks/s", snapshot.ticks_per_second);
+    ImGui::Text("UI: %.1f FPS", ImGui::GetIO().Framerate);
 
-    ImGui::Begin("Network Viewer");
-    ImGui::Text("Draw NEAT network nodes + edges here.");
     ImGui::End();
 }
 
@@ -93,8 +191,10 @@ void ImGuiHandler::initDefaultLayout()
 
     // Dock windows by title
     ImGui::DockBuilderDockWindow("Control Panel", dock_id_left);
-    ImGui::DockBuilderDockWindow("Crypto Chart", dock_main_id);
+    ImGui::DockBuilderDockWindow("World", dock_main_id);
     ImGui::DockBuilderDockWindow("Network Viewer", dock_main_id);
+    ImGui::DockBuilderDockWindow("Encounter Metrics", dock_id_bottom);
+    ImGui::DockBuilderDockWindow("Profiler", dock_id_bottom);
 
     ImGui::DockBuilderFinish(dockspace_id);
 }
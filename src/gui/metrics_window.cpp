@@ -0,0 +1,189 @@
+#include "metrics_window.hpp"
+
+#include "sim/simulation_thread.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+const ImU32 series_colors[sim::encounter_metric_count] = {
+    IM_COL32(230, 60, 60, 255),   // Boss HP
+    IM_COL32(80, 220, 80, 255),   // Party HP
+    IM_COL32(90, 140, 255, 255),  // Tank threat (role colours match the world view)
+    IM_COL32(90, 230, 120, 255),  // Healer threat
+    IM_COL32(255, 210, 80, 255),  // DPS threat
+    IM_COL32(220, 220, 220, 255), // Reward
+};
+
+} // namespace
+
+void MetricsWindow::draw(const sim::SimulationThread* sim_thread)
+{
+
+    if (!ImGui::Begin("Encounter Metrics") || !sim_thread)
+    {
+        ImGui::End();
+        return;
+    }
+
+    const sim::MetricStore& store = sim_thread->getMetrics();
+    const std::uint64_t total = store.size();
+    if (total == 0)
+    {
+        ImGui::Text("No showcase running - metrics are sampled from the watched generation.");
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Checkbox("Whole run", &whole_run);
+    if (!whole_run)
+    {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(240.0f);
+        const float most = std::max(600.0f, static_cast<float>(total));
+        ImGui::SliderFloat("Span", &span_ticks, 60.0f, most, "%.0f ticks", ImGuiSliderFlags_Logarithmic);
+    }
+    ImGui::SameLine();
+    ImGui::Text("%llu ticks recorded", static_cast<unsigned long long>(total));
+
+    const std::uint64_t span = whole_run ? total : static_cast<std::uint64_t>(std::max(1.0f, span_ticks));
+    last = total;
+    first = total > span ? total - span : 0;
+
+    const float plot_height = std::max(60.0f, (ImGui::GetContentRegionAvail().y - 3.0f * ImGui::GetFrameHeight()) / 3);
+    drawPlot("Health", store, {sim::BossHealth, sim::PartyHealth}, 0.0f, 1.0f, plot_height);
+    drawPlot("Threat", store, {sim::TankThreat, sim::HealerThreat, sim::DpsThreat}, 0.0f, 1.0f, plot_height);
+    drawPlot("Reward", store, {sim::Reward}, 0.0f, 0.0f, plot_height);
+
+    ImGui::End();
+}
+
+void MetricsWindow::drawPlot(const char* id, const sim::MetricStore& store, std::initializer_list<std::size_t> series,
+                             float y_min, float y_max, float height)
+{
+
+    const float width = std::max(1.0f, ImGui::GetContentRegionAvail().x);
+    const std::size_t max_buckets = static_cast<std::size_t>(width);
+
+    // Fetch first so auto-ranged axes know the extent.
+    buckets.resize(std::max(buckets.size(), series.size()));
+    bool fit = y_min == y_max;
+    float data_min = 0.0f, data_max = 0.0f;
+    bool any = false;
+    std::size_t slot = 0;
+    for (std::size_t s : series)
+    {
+        store.downsample(s, first, last, max_buckets, buckets[slot]);
+        for (const sim::MetricBucket& bucket : buckets[slot])
+        {
+            data_min = any ? std::min(data_min, bucket.min) : bucket.min;
+            data_max = any ? std::max(data_max, bucket.max) : bucket.max;
+            any = true;
+        }
+        ++slot;
+    }
+    if (fit)
+    {
+        y_min = data_min;
+        y_max = data_max > data_min ? data_max : data_min + 1.0f;
+    }
+
+    // Legend, with the newest sample of each series (not a bucket's max, which a zoomed-out plot smears over
+    // thousands of ticks).
+    bool first_entry = true;
+    for (std::size_t s : series)
+    {
+        if (!first_entry)
+        {
+            ImGui::SameLine();
+        }
+        first_entry = false;
+        ImGui::PushStyleColor(ImGuiCol_Text, series_colors[s]);
+        ImGui::Text("%s %.2f", store.getNames()[s].c_str(), store.latest(s));
+        ImGui::PopStyleColor();
+    }
+
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const ImVec2 corner(origin.x + width, origin.y + height);
+    ImGui::InvisibleButton(id, ImVec2(width, height));
+    const bool hovered = ImGui::IsItemHovered();
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(origin, corner, IM_COL32(25, 25, 25, 255));
+    draw_list->AddRect(origin, corner, IM_COL32(70, 70, 70, 255));
+    draw_list->PushClipRect(origin, corner, true);
+
+    const double x_scale = width / static_cast<double>(std::max<std::uint64_t>(1, last - first));
+    const float y_scale = (height - 2.0f) / (y_max - y_min);
+    auto toX = [&](std::uint64_t sample) {
+        return origin.x + static_cast<float>(static_cast<double>(sample - std::min(sample, first)) * x_scale);
+    };
+    auto toY = [&](float value) { return corner.y - 1.0f - (value - y_min) * y_scale; };
+
+    // Each bucket draws as its min..max band, so a zoomed-out plot shows the envelope rather than a thinned line.
+    slot = 0;
+    for (std::size_t s : series)
+    {
+        const std::vector<sim::MetricBucket>& data = buckets[slot++];
+        upper.clear();
+        lower.clear();
+        for (const sim::MetricBucket& bucket : data)
+        {
+            const float x = toX(bucket.first + bucket.count / 2);
+            upper.emplace_back(x, toY(bucket.max));
+            lower.emplace_back(x, toY(bucket.min));
+            if (bucket.min != bucket.max)
+            {
+                draw_list->AddLine(upper.back(), lower.back(), (series_colors[s] & 0x00ffffffu) | 0x60000000u);
+            }
+        }
+        draw_list->AddPolyline(upper.data(), static_cast<int>(upper.size()), series_colors[s], 0, 1.0f);
+        draw_list->AddPolyline(lower.data(), static_cast<int>(lower.size()), series_colors[s], 0, 1.0f);
+    }
+
+    char label[32];
+    std::snprintf(label, sizeof(label), "%.3g", y_max);
+    draw_list->AddText(ImVec2(origin.x + 4.0f, origin.y + 2.0f), IM_COL32(150, 150, 150, 255), label);
+    std::snprintf(label, sizeof(label), "%.3g", y_min);
+    draw_list->AddText(ImVec2(origin.x + 4.0f, corner.y - ImGui::GetTextLineHeight() - 2.0f),
+                       IM_COL32(150, 150, 150, 255), label);
+
+    draw_list->PopClipRect();
+
+    if (!hovered)
+    {
+        return;
+    }
+
+    // Read back the bucket under the cursor in every series.
+    const float mouse_x = ImGui::GetIO().MousePos.x;
+    draw_list->AddLine(ImVec2(mouse_x, origin.y), ImVec2(mouse_x, corner.y), IM_COL32(200, 200, 200, 90));
+    const std::uint64_t tick = first + static_cast<std::uint64_t>(std::max(0.0f, mouse_x - origin.x) / x_scale);
+
+    ImGui::BeginTooltip();
+    ImGui::Text("Tick %llu", static_cast<unsigned long long>(tick));
+    slot = 0;
+    for (std::size_t s : series)
+    {
+        const std::vector<sim::MetricBucket>& data = buckets[slot++];
+        auto it = std::upper_bound(data.begin(), data.end(), tick,
+                                   [](std::uint64_t t, const sim::MetricBucket& b) { return t < b.first; });
+        if (it == data.begin())
+        {
+            continue;
+        }
+        --it;
+        ImGui::PushStyleColor(ImGuiCol_Text, series_colors[s]);
+        if (it->min == it->max)
+        {
+            ImGui::Text("%s: %.3f", store.getNames()[s].c_str(), it->min);
+        }
+        else
+        {
+            ImGui::Text("%s: %.3f .. %.3f", store.getNames()[s].c_str(), it->min, it->max);
+        }
+        ImGui::PopStyleColor();
+    }
+    ImGui::EndTooltip();
+}
@@ -0,0 +1,513 @@
+#include "network_viewer.hpp"
+
+#include "sim/simulation_thread.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr float node_spacing = 1.0f;   // Between neighbours in a layer, layout units
+constexpr float target_aspect = 1.6f;  // Layers are spread to roughly this width:height
+constexpr int ordering_sweeps = 2;     // Forward + backward barycentre passes
+
+ImU32 nodeColor(neat::NodeType type)
+{
+
+    switch (type)
+    {
+    case neat::NodeType::Input:
+        return IM_COL32(110, 170, 255, 255);
+    case neat::NodeType::Bias:
+        return IM_COL32(150, 150, 150, 255);
+    case neat::NodeType::Output:
+        return IM_COL32(255, 170, 70, 255);
+    default:
+        return IM_COL32(230, 230, 230, 255);
+    }
+}
+
+const char* roleName(sim::Role role)
+{
+
+    switch (role)
+    {
+    case sim::Role::Tank:
+        return "Tank";
+    case sim::Role::Healer:
+        return "Healer";
+    default:
+        return "DPS";
+    }
+}
+
+// Scales an opaque colour's channels towards black, by 1 - level.
+ImU32 dimmed(ImU32 color, float level)
+{
+
+    const float keep = 0.2f + 0.8f * std::clamp(level, 0.0f, 1.0f);
+    ImVec4 rgba = ImGui::ColorConvertU32ToFloat4(color);
+    return ImGui::GetColorU32(ImVec4(rgba.x * keep, rgba.y * keep, rgba.z * keep, 1.0f));
+}
+
+const char* nodeTypeName(neat::NodeType type)
+{
+
+    switch (type)
+    {
+    case neat::NodeType::Input:
+        return "Input";
+    case neat::NodeType::Bias:
+        return "Bias";
+    case neat::NodeType::Output:
+        return "Output";
+    default:
+        return "Hidden";
+    }
+}
+
+} // namespace
+
+void NetworkLayout::build(const sim::NetworkTopology& topology)
+{
+
+    const std::size_t count = topology.node_types.size();
+    nodes.assign(count, Node{});
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        nodes[n].type = topology.node_types[n];
+    }
+
+    edges.clear();
+    max_weight = 0.0f;
+    for (std::size_t c = 0; c < topology.edge_in.size(); ++c)
+    {
+        if (topology.edge_in[c] >= count || topology.edge_out[c] >= count)
+        {
+            continue;
+        }
+        edges.push_back({topology.edge_in[c], topology.edge_out[c], topology.edge_weight[c],
+                         topology.edge_enabled[c] != 0});
+        if (edges.back().enabled)
+        {
+            max_weight = std::max(max_weight, std::fabs(edges.back().weight));
+        }
+    }
+    std::sort(edges.begin(), edges.end(),
+              [](const Edge& a, const Edge& b) { return std::fabs(a.weight) > std::fabs(b.weight); });
+
+    // Layers: longest path over enabled connections (genomes are acyclic), taken in topological order.
+    std::vector<std::uint32_t> pending(count, 0);
+    std::vector<std::uint32_t> first_out(count + 1, 0), targets;
+    for (const Edge& edge : edges)
+    {
+        if (edge.enabled)
+        {
+            ++first_out[edge.from + 1];
+            ++pending[edge.to];
+        }
+    }
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        first_out[n + 1] += first_out[n];
+    }
+    targets.resize(first_out[count]);
+    std::vector<std::uint32_t> fill(first_out.begin(), first_out.end() - 1);
+    for (const Edge& edge : edges)
+    {
+        if (edge.enabled)
+        {
+            targets[fill[edge.from]++] = edge.to;
+        }
+    }
+
+    std::vector<std::uint32_t> layer(count, 0);
+    std::vector<std::uint32_t> ready;
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        if (pending[n] == 0)
+        {
+            ready.push_back(static_cast<std::uint32_t>(n));
+        }
+    }
+    while (!ready.empty())
+    {
+        const std::uint32_t n = ready.back();
+        ready.pop_back();
+        if (nodes[n].type == neat::NodeType::Hidden)
+        {
+            layer[n] = std::max<std::uint32_t>(layer[n], 1); // Unconnected hidden nodes still sit past the inputs
+        }
+        for (std::uint32_t e = first_out[n]; e < first_out[n + 1]; ++e)
+        {
+            const std::uint32_t to = targets[e];
+            layer[to] = std::max(layer[to], layer[n] + 1);
+            if (--pending[to] == 0)
+            {
+                ready.push_back(to);
+            }
+        }
+    }
+
+    // Outputs all go in one column after everything else.
+    std::uint32_t output_layer = 1;
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        if (nodes[n].type != neat::NodeType::Output)
+        {
+            output_layer = std::max(output_layer, layer[n] + 1);
+        }
+    }
+    layer_count = output_layer + 1;
+
+    std::vector<std::vector<std::uint32_t>> columns(layer_count);
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        if (nodes[n].type == neat::NodeType::Output)
+        {
+            layer[n] = output_layer;
+        }
+        else if (nodes[n].type != neat::NodeType::Hidden)
+        {
+            layer[n] = 0;
+        }
+        columns[layer[n]].push_back(static_cast<std::uint32_t>(n));
+    }
+
+    auto place = [&](std::uint32_t l) {
+        const std::vector<std::uint32_t>& column = columns[l];
+        for (std::size_t i = 0; i < column.size(); ++i)
+        {
+            nodes[column[i]].y = (static_cast<float>(i) - 0.5f * (column.size() - 1)) * node_spacing;
+        }
+    };
+    for (std::uint32_t l = 0; l < layer_count; ++l)
+    {
+        place(l);
+    }
+
+    // Hidden columns sorted by the mean height of their neighbours, forward then backward. Inputs and outputs keep
+    // genome order so they stay put between generations.
+    std::vector<float> sum(count), weight(count);
+    for (int sweep = 0; sweep < 2 * ordering_sweeps; ++sweep)
+    {
+        const bool forward = sweep % 2 == 0;
+        for (std::uint32_t step = 1; step + 1 < layer_count; ++step)
+        {
+            const std::uint32_t l = forward ? step : layer_count - 1 - step;
+            std::vector<std::uint32_t>& column = columns[l];
+
+            for (std::uint32_t n : column)
+            {
+                sum[n] = nodes[n].y;
+                weight[n] = 1.0f;
+            }
+            for (const Edge& edge : edges)
+            {
+                const std::uint32_t self = forward ? edge.to : edge.from;
+                const std::uint32_t other = forward ? edge.from : edge.to;
+                if (edge.enabled && layer[self] == l)
+                {
+                    sum[self] += nodes[other].y;
+                    weight[self] += 1.0f;
+                }
+            }
+            std::stable_sort(column.begin(), column.end(), [&](std::uint32_t a, std::uint32_t b) {
+                return sum[a] / weight[a] < sum[b] / weight[b];
+            });
+            place(l);
+        }
+    }
+
+    // Spread the layers so the whole thing comes out landscape rather than a tall thin strip.
+    std::size_t tallest = 1;
+    for (const std::vector<std::uint32_t>& column : columns)
+    {
+        tallest = std::max(tallest, column.size());
+    }
+    const float gap = std::max(node_spacing, target_aspect * tallest * node_spacing / std::max(1u, layer_count - 1));
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        nodes[n].x = layer[n] * gap;
+    }
+
+    min_x = min_y = max_x = max_y = 0.0f;
+    for (const Node& node : nodes)
+    {
+        min_x = std::min(min_x, node.x);
+        max_x = std::max(max_x, node.x);
+        min_y = std::min(min_y, node.y);
+        max_y = std::max(max_y, node.y);
+    }
+}
+
+std::size_t NetworkLayout::edgesAtLeast(float threshold) const
+{
+
+    auto end = std::partition_point(edges.begin(), edges.end(),
+                                    [threshold](const Edge& e) { return std::fabs(e.weight) >= threshold; });
+    return static_cast<std::size_t>(end - edges.begin());
+}
+
+void NetworkViewer::draw(sim::SimulationThread* sim_thread)
+{
+
+    if (!ImGui::Begin("Network Viewer") || !sim_thread)
+    {
+        ImGui::End();
+        return;
+    }
+
+    const sim::NetworkTopology& topology = sim_thread->latestTopology();
+    if (topology.version != layout_version)
+    {
+        layout.build(topology);
+        layout_version = topology.version;
+        ++layout_builds;
+        if (topology.genome != layout_genome)
+        {
+            fit_pending = true; // A different genome; a new generation of the same one keeps the view
+            layout_genome = topology.genome;
+            genome_input = static_cast<int>(topology.genome);
+        }
+    }
+
+    ImGui::SetNextItemWidth(120.0f);
+    if (ImGui::InputInt("Genome", &genome_input))
+    {
+        const int last = std::max(0, static_cast<int>(topology.genome_count) - 1);
+        genome_input = std::clamp(genome_input, 0, last);
+        sim_thread->watchGenome(static_cast<std::size_t>(genome_input));
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Fit"))
+    {
+        fit_pending = true;
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Disabled", &show_disabled);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(140.0f);
+    ImGui::SliderFloat("Min |w|", &min_weight, 0.0f, std::max(0.01f, layout.maxWeight()), "%.2f");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(140.0f);
+    ImGui::SliderInt("Edge budget", &edge_budget, 100, 20000, "%d", ImGuiSliderFlags_Logarithmic);
+
+    // Activations line up with the nodes only while both describe the same genome of the same generation.
+    const sim::ActivationFrame& frame = sim_thread->latestActivations();
+    const bool frame_matches = frame.generation == topology.generation && frame.genome == topology.genome &&
+                               frame.values.size() == layout.getNodes().size();
+
+    ImGui::Checkbox("Live", &live);
+    if (live && !frame.party.empty())
+    {
+        ImGui::SameLine();
+        drawSlotPicker(sim_thread, frame);
+    }
+
+    ImGui::Text("Generation %llu, genome %zu: %zu nodes, %zu connections, %u layers - drawn %zu nodes, %zu edges "
+                "(layout built %llu times)",
+                static_cast<unsigned long long>(topology.generation), topology.genome, layout.getNodes().size(),
+                layout.getEdges().size(), layout.layerCount(), nodes_drawn, edges_drawn,
+                static_cast<unsigned long long>(layout_builds));
+
+    drawCanvas(live && frame_matches ? &frame.values : nullptr);
+
+    ImGui::End();
+}
+
+void NetworkViewer::drawSlotPicker(sim::SimulationThread* sim_thread, const sim::ActivationFrame& frame)
+{
+
+    // The whole party runs the same genome, so picking a member only changes which inputs it is seeing.
+    std::uint32_t dps = 0;
+    for (std::uint32_t slot = 0; slot < frame.party.size(); ++slot)
+    {
+        char label[32];
+        if (frame.party[slot] == sim::Role::Dps)
+        {
+            std::snprintf(label, sizeof(label), "DPS %u##slot%u", ++dps, slot);
+        }
+        else
+        {
+            std::snprintf(label, sizeof(label), "%s##slot%u", roleName(frame.party[slot]), slot);
+        }
+
+        if (slot > 0)
+        {
+            ImGui::SameLine();
+        }
+        if (ImGui::RadioButton(label, frame.slot == slot))
+        {
+            sim_thread->watchSlot(slot);
+        }
+    }
+}
+
+void NetworkViewer::fit(const ImVec2& size)
+{
+
+    const float margin = 24.0f;
+    const float width = std::max(1e-3f, layout.max_x - layout.min_x);
+    const float height = std::max(1e-3f, layout.max_y - layout.min_y);
+    zoom = std::max(1.0f, std::min((size.x - 2.0f * margin) / width, (size.y - 2.0f * margin) / height));
+    pan = ImVec2(0.5f * size.x - 0.5f * (layout.min_x + layout.max_x) * zoom,
+                 0.5f * size.y - 0.5f * (layout.min_y + layout.max_y) * zoom);
+    fit_pending = false;
+}
+
+void NetworkViewer::drawCanvas(const std::vector<float>* values)
+{
+
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const ImVec2 avail = ImGui::GetContentRegionAvail();
+    const ImVec2 size(std::max(50.0f, avail.x), std::max(50.0f, avail.y));
+    const ImVec2 corner(origin.x + size.x, origin.y + size.y);
+
+    ImGui::InvisibleButton("canvas", size, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonMiddle);
+    const bool hovered = ImGui::IsItemHovered();
+    const ImGuiIO& io = ImGui::GetIO();
+
+    if (fit_pending)
+    {
+        fit(size);
+    }
+    if (ImGui::IsItemActive() &&
+        (ImGui::IsMouseDragging(ImGuiMouseButton_Left) || ImGui::IsMouseDragging(ImGuiMouseButton_Middle)))
+    {
+        pan.x += io.MouseDelta.x;
+        pan.y += io.MouseDelta.y;
+    }
+    if (hovered && io.MouseWheel != 0.0f)
+    {
+        // Keep the point under the cursor where it is.
+        const float local_x = (io.MousePos.x - origin.x - pan.x) / zoom;
+        const float local_y = (io.MousePos.y - origin.y - pan.y) / zoom;
+        zoom = std::clamp(zoom * std::pow(1.15f, io.MouseWheel), 0.5f, 5000.0f);
+        pan = ImVec2(io.MousePos.x - origin.x - local_x * zoom, io.MousePos.y - origin.y - local_y * zoom);
+    }
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(origin, corner, IM_COL32(20, 20, 24, 255));
+    draw_list->PushClipRect(origin, corner, true);
+
+    const std::vector<NetworkLayout::Node>& nodes = layout.getNodes();
+    auto toScreen = [&](const NetworkLayout::Node& node) {
+        return ImVec2(origin.x + pan.x + node.x * zoom, origin.y + pan.y + node.y * zoom);
+    };
+
+    // Strongest first, so culling by threshold and budget is just where to stop. Edges too faint to see stop it
+    // too - everything after them is fainter still.
+    const std::vector<NetworkLayout::Edge>& edges = layout.getEdges();
+    const std::size_t candidates = std::min(layout.edgesAtLeast(min_weight), static_cast<std::size_t>(edge_budget));
+    const float inverse_max = layout.maxWeight() > 0.0f ? 1.0f / layout.maxWeight() : 0.0f;
+    const float thickness_scale = std::clamp(zoom * 0.03f, 0.5f, 3.0f);
+
+    edges_drawn = 0;
+    for (std::size_t e = 0; e < candidates; ++e)
+    {
+        const NetworkLayout::Edge& edge = edges[e];
+        const float weight_strength = std::min(1.0f, std::fabs(edge.weight) * inverse_max);
+        if (weight_strength < 0.02f)
+        {
+            break;
+        }
+        if (!edge.enabled && !show_disabled)
+        {
+            continue;
+        }
+
+        // Live, an edge shows what it is carrying right now rather than what it could.
+        const float signal = values ? (*values)[edge.from] * edge.weight : edge.weight;
+        const float strength = std::min(1.0f, std::fabs(signal) * inverse_max);
+        if (values && strength < 0.02f)
+        {
+            continue;
+        }
+        const int alpha = static_cast<int>(40.0f + 200.0f * strength);
+
+        const ImVec2 a = toScreen(nodes[edge.from]);
+        const ImVec2 b = toScreen(nodes[edge.to]);
+        if ((a.x < origin.x && b.x < origin.x) || (a.x > corner.x && b.x > corner.x) ||
+            (a.y < origin.y && b.y < origin.y) || (a.y > corner.y && b.y > corner.y))
+        {
+            continue; // Entirely off one side of the canvas
+        }
+
+        ImU32 color = signal >= 0.0f ? IM_COL32(240, 140, 60, alpha) : IM_COL32(80, 150, 255, alpha);
+        if (!edge.enabled)
+        {
+            color = IM_COL32(120, 120, 120, 60);
+        }
+        draw_list->AddLine(a, b, color, thickness_scale * (0.5f + 1.5f * strength));
+        ++edges_drawn;
+    }
+
+    // Zoomed far out a node is a few pixels either way; squares are far cheaper than circles.
+    const float radius = std::clamp(zoom * 0.18f, 1.5f, 10.0f);
+    const float hover_radius = radius + 3.0f;
+    std::size_t hovered_node = nodes.size();
+    nodes_drawn = 0;
+    for (std::size_t n = 0; n < nodes.size(); ++n)
+    {
+        const ImVec2 p = toScreen(nodes[n]);
+        if (p.x < origin.x - radius || p.x > corner.x + radius || p.y < origin.y - radius || p.y > corner.y + radius)
+        {
+            continue;
+        }
+
+        // Inputs are raw sensor readings (roughly -1..1), everything else a sigmoid (0..1, firing above 0.5).
+        ImU32 color = nodeColor(nodes[n].type);
+        bool firing = false;
+        if (values)
+        {
+            const float value = (*values)[n];
+            const bool input = nodes[n].type == neat::NodeType::Input || nodes[n].type == neat::NodeType::Bias;
+            color = dimmed(color, input ? std::fabs(value) : value);
+            firing = !input && value > 0.5f;
+        }
+
+        if (radius < 3.0f)
+        {
+            draw_list->AddRectFilled(ImVec2(p.x - radius, p.y - radius), ImVec2(p.x + radius, p.y + radius), color);
+        }
+        else
+        {
+            draw_list->AddCircleFilled(p, radius, color, 12);
+            if (firing)
+            {
+                draw_list->AddCircle(p, radius + 2.0f, IM_COL32(255, 255, 255, 220), 12, 1.5f);
+            }
+        }
+        ++nodes_drawn;
+
+        const float dx = io.MousePos.x - p.x;
+        const float dy = io.MousePos.y - p.y;
+        if (hovered && dx * dx + dy * dy <= hover_radius * hover_radius)
+        {
+            hovered_node = n;
+        }
+    }
+
+    draw_list->PopClipRect();
+
+    if (hovered_node < nodes.size())
+    {
+        std::size_t incoming = 0, outgoing = 0;
+        for (const NetworkLayout::Edge& edge : edges)
+        {
+            incoming += edge.enabled && edge.to == hovered_node ? 1 : 0;
+            outgoing += edge.enabled && edge.from == hovered_node ? 1 : 0;
+        }
+
+        ImGui::BeginTooltip();
+        ImGui::Text("%s node %zu", nodeTypeName(nodes[hovered_node].type), hovered_node);
+        ImGui::Text("%zu in, %zu out", incoming, outgoing);
+        if (values)
+        {
+            ImGui::Text("Activation %.3f", (*values)[hovered_node]);
+        }
+        ImGui::EndTooltip();
+    }
+}
@@ -0,0 +1,324 @@
+#include "profiler_window.hpp"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+namespace {
+
+constexpr float row_height = 18.0f;
+constexpr float label_min_width = 40.0f; // Narrower bars go unlabelled
+
+// Same name, same colour, on every thread and every run.
+ImU32 scopeColor(const char* name)
+{
+
+    std::uint32_t h = 2166136261u; // FNV-1a
+    for (const char* c = name; *c; ++c)
+    {
+        h = (h ^ static_cast<unsigned char>(*c)) * 16777619u;
+    }
+
+    float r, g, b;
+    ImGui::ColorConvertHSVtoRGB(static_cast<float>(h % 360) / 360.0f, 0.55f, 0.85f, r, g, b);
+    return ImGui::GetColorU32(ImVec4(r, g, b, 1.0f));
+}
+
+double toMs(std::uint64_t ns) { return static_cast<double>(ns) * 1e-6; }
+
+} // namespace
+
+void ProfilerWindow::collect()
+{
+
+    for (neat::ProfileReader::ThreadEvents& thread : reader.poll())
+    {
+        if (thread.thread_id >= lanes.size())
+        {
+            lanes.resize(thread.thread_id + 1);
+        }
+
+        Lane& lane = lanes[thread.thread_id];
+        lane.name = std::move(thread.thread_name);
+        lane.dropped += thread.dropped;
+        for (const neat::ProfileEvent& event : thread.events)
+        {
+            lane.events.push_back(event);
+            lane.max_depth = std::max(lane.max_depth, event.depth);
+            latest_ns = std::max(latest_ns, event.end_ns);
+        }
+    }
+
+    // Trim to the history length. Events are in end order, so the old ones are all at the front.
+    const std::uint64_t history_ns = static_cast<std::uint64_t>(history_seconds * 1e9f);
+    const std::uint64_t oldest = latest_ns > history_ns ? latest_ns - history_ns : 0;
+    for (Lane& lane : lanes)
+    {
+        while (!lane.events.empty() && lane.events.front().end_ns < oldest)
+        {
+            lane.events.pop_front();
+        }
+    }
+}
+
+void ProfilerWindow::draw()
+{
+
+    // Keeps reading while hidden too, so the history is there when the window is opened.
+    collect();
+
+    if (!ImGui::Begin("Profiler"))
+    {
+        ImGui::End();
+        return;
+    }
+
+    bool enabled = neat::Profiler::enabled();
+    if (ImGui::Checkbox("Record", &enabled))
+    {
+        neat::Profiler::setEnabled(enabled);
+    }
+    ImGui::SameLine();
+    if (ImGui::Checkbox("Freeze", &frozen))
+    {
+        frozen_end = latest_ns;
+        scroll_back_ms = 0.0f;
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(160.0f);
+    ImGui::SliderFloat("Window", &view_ms, 1.0f, 2000.0f, "%.0f ms", ImGuiSliderFlags_Logarithmic);
+
+    if (frozen)
+    {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(200.0f);
+        ImGui::SliderFloat("Scroll back", &scroll_back_ms, 0.0f, history_seconds * 1000.0f, "%.0f ms");
+    }
+
+    const std::uint64_t view_ns = static_cast<std::uint64_t>(static_cast<double>(view_ms) * 1e6);
+    const std::uint64_t back_ns = frozen ? static_cast<std::uint64_t>(static_cast<double>(scroll_back_ms) * 1e6) : 0;
+    const std::uint64_t right = frozen ? frozen_end : latest_ns;
+    const std::uint64_t view_end = right > back_ns ? right - back_ns : 0;
+    const std::uint64_t view_start = view_end > view_ns ? view_end - view_ns : 0;
+
+    drawTraceControls();
+
+    ImGui::Separator();
+
+    if (ImGui::BeginChild("Lanes", ImVec2(0.0f, ImGui::GetContentRegionAvail().y * 0.65f)))
+    {
+        for (Lane& lane : lanes)
+        {
+            if (!lane.events.empty())
+            {
+                drawLane(lane, view_start, view_end);
+            }
+        }
+    }
+    ImGui::EndChild();
+
+    drawTotals(view_start, view_end);
+
+    ImGui::End();
+}
+
+void ProfilerWindow::drawTraceControls()
+{
+
+    if (!trace)
+    {
+        ImGui::SetNextItemWidth(240.0f);
+        ImGui::InputText("##trace path", trace_path, sizeof(trace_path));
+        ImGui::SameLine();
+        if (ImGui::Button("Record trace"))
+        {
+            try
+            {
+                trace = std::make_unique<neat::TraceWriter>(trace_path);
+                trace_status.clear();
+            }
+            catch (const std::runtime_error& e)
+            {
+                trace_status = e.what();
+            }
+        }
+    }
+    else
+    {
+        if (ImGui::Button("Stop trace"))
+        {
+            trace->finish();
+            trace_status = std::to_string(trace->eventsWritten()) + " events written to " + trace->getPath();
+            if (!trace->lastError().empty())
+            {
+                trace_status = trace->lastError();
+            }
+            trace.reset();
+        }
+        else
+        {
+            ImGui::SameLine();
+            ImGui::Text("Recording to %s: %llu events, %llu dropped", trace->getPath().c_str(),
+                        static_cast<unsigned long long>(trace->eventsWritten()),
+                        static_cast<unsigned long long>(trace->dropped()));
+        }
+    }
+
+    if (!trace && !trace_status.empty())
+    {
+        ImGui::SameLine();
+        ImGui::TextUnformatted(trace_status.c_str());
+    }
+}
+
+void ProfilerWindow::drawLane(Lane& lane, std::uint64_t view_start, std::uint64_t view_end)
+{
+
+    if (lane.dropped > 0)
+    {
+        ImGui::Text("%s (%llu events dropped)", lane.name.c_str(), static_cast<unsigned long long>(lane.dropped));
+    }
+    else
+    {
+        ImGui::TextUnformatted(lane.name.c_str());
+    }
+
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = std::max(1.0f, ImGui::GetContentRegionAvail().x);
+    const float height = (lane.max_depth + 1) * row_height;
+    ImGui::PushID(lane.name.c_str());
+    ImGui::InvisibleButton("lane", ImVec2(width, height));
+    ImGui::PopID();
+    const bool hovered = ImGui::IsItemHovered();
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + height), IM_COL32(30, 30, 30, 255));
+    draw_list->PushClipRect(origin, ImVec2(origin.x + width, origin.y + height), true);
+
+    const double pixels_per_ns = width / static_cast<double>(std::max<std::uint64_t>(1, view_end - view_start));
+
+    // Zoomed out, thousands of scopes can share a pixel. Only the first to reach each pixel of a row is drawn
+    // (stretched to a pixel wide), so the cost is bounded by the lane's width rather than its event count.
+    std::vector<float> row_covered(lane.max_depth + 1, -1.0f);
+
+    // Sorted by end: skip straight to the first event still open at the left edge.
+    auto first = std::lower_bound(lane.events.begin(), lane.events.end(), view_start,
+                                  [](const neat::ProfileEvent& e, std::uint64_t t) { return e.end_ns < t; });
+
+    const neat::ProfileEvent* tooltip = nullptr;
+    for (auto it = first; it != lane.events.end(); ++it)
+    {
+        const neat::ProfileEvent& event = *it;
+        if (event.start_ns > view_end)
+        {
+            // Past the right edge. Once a top-level scope is, so is everything after it: later events either
+            // nest inside later top-level scopes or are those scopes.
+            if (event.depth == 0)
+            {
+                break;
+            }
+            continue;
+        }
+
+        const double rel_start = static_cast<double>(event.start_ns) - static_cast<double>(view_start);
+        const double rel_end = static_cast<double>(event.end_ns) - static_cast<double>(view_start);
+        const float x0 = origin.x + static_cast<float>(std::max(0.0, rel_start) * pixels_per_ns);
+        const float x1 = std::max(x0 + 1.0f, origin.x + static_cast<float>(rel_end * pixels_per_ns));
+
+        float& covered = row_covered[event.depth];
+        if (x1 <= covered)
+        {
+            continue;
+        }
+        covered = std::floor(x0) + 1.0f;
+
+        const float y0 = origin.y + event.depth * row_height;
+        const float y1 = y0 + row_height - 1.0f;
+        draw_list->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), scopeColor(event.name));
+
+        if (x1 - x0 >= label_min_width)
+        {
+            draw_list->PushClipRect(ImVec2(x0, y0), ImVec2(x1, y1), true);
+            draw_list->AddText(ImVec2(x0 + 3.0f, y0 + 1.0f), IM_COL32(0, 0, 0, 255), event.name);
+            draw_list->PopClipRect();
+        }
+
+        if (hovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1)
+        {
+            tooltip = &event;
+        }
+    }
+
+    draw_list->PopClipRect();
+
+    if (tooltip)
+    {
+        ImGui::BeginTooltip();
+        ImGui::Text("%s", tooltip->name);
+        ImGui::Text("%.3f ms", toMs(tooltip->end_ns - tooltip->start_ns));
+        ImGui::EndTooltip();
+    }
+}
+
+void ProfilerWindow::drawTotals(std::uint64_t view_start, std::uint64_t view_end) const
+{
+
+    struct Total {
+        std::uint64_t ns = 0;
+        std::uint64_t count = 0;
+        std::uint64_t longest = 0;
+    };
+
+    // Keyed by text, not pointer: the same literal may live at different addresses in different translation units.
+    std::map<std::string, Total> totals;
+    for (const Lane& lane : lanes)
+    {
+        for (const neat::ProfileEvent& event : lane.events)
+        {
+            if (event.end_ns < view_start || event.start_ns > view_end)
+            {
+                continue;
+            }
+            Total& total = totals[event.name];
+            const std::uint64_t duration = event.end_ns - event.start_ns;
+            total.ns += duration;
+            total.count += 1;
+            total.longest = std::max(total.longest, duration);
+        }
+    }
+
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (!ImGui::BeginTable("Totals", 5, flags))
+    {
+        return;
+    }
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Scope");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Total ms");
+    ImGui::TableSetupColumn("Mean ms");
+    ImGui::TableSetupColumn("Max ms");
+    ImGui::TableHeadersRow();
+
+    for (const auto& [name, total] : totals)
+    {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(name.c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(total.count));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", toMs(total.ns));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", toMs(total.ns) / static_cast<double>(total.count));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", toMs(total.longest));
+    }
+
+    ImGui::EndTable();
+}
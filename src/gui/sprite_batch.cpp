@@ -0,0 +1,241 @@
+#include "sprite_batch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+const char *vertex_source = R"(#version 330 core
+layout(location = 0) in vec4 a_rect; // centre x, centre y, width, height
+layout(location = 1) in float a_rotation;
+layout(location = 2) in vec4 a_uv;
+layout(location = 3) in vec4 a_color;
+
+uniform vec4 u_view;
+
+out vec2 v_uv;
+out vec4 v_color;
+
+void main()
+{
+    // Triangle strip over the unit square: (0,0) (1,0) (0,1) (1,1)
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    vec2 local = (corner - 0.5) * a_rect.zw;
+    float c = cos(a_rotation);
+    float s = sin(a_rotation);
+    vec2 world = a_rect.xy + vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+
+    gl_Position = vec4(world * u_view.xy + u_view.zw, 0.0, 1.0);
+    v_uv = vec2(mix(a_uv.x, a_uv.z, corner.x), mix(a_uv.w, a_uv.y, corner.y)); // Image top at the quad's top
+    v_color = a_color;
+}
+)";
+
+const char *fragment_source = R"(#version 330 core
+in vec2 v_uv;
+in vec4 v_color;
+
+uniform sampler2D u_texture;
+
+out vec4 frag_color;
+
+void main()
+{
+    frag_color = texture(u_texture, v_uv) * v_color;
+}
+)";
+
+GLuint compileShader(GLenum type, const char *source)
+{
+
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint ok = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok)
+    {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        glDeleteShader(shader);
+        throw std::runtime_error(std::string("Sprite shader failed to compile: ") + log);
+    }
+    return shader;
+}
+
+} // namespace
+
+SpriteBatch::SpriteBatch(std::size_t layer_count) : layers(layer_count) {}
+
+void SpriteBatch::init()
+{
+
+    const GLuint vertex = compileShader(GL_VERTEX_SHADER, vertex_source);
+    const GLuint fragment = compileShader(GL_FRAGMENT_SHADER, fragment_source);
+
+    program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    glLinkProgram(program);
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok)
+    {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        throw std::runtime_error(std::string("Sprite shader failed to link: ") + log);
+    }
+
+    view_location = glGetUniformLocation(program, "u_view");
+    texture_location = glGetUniformLocation(program, "u_texture");
+
+    // No per-vertex data at all: every attribute advances once per instance.
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    for (GLuint attribute = 0; attribute < 4; ++attribute)
+    {
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribDivisor(attribute, 1);
+    }
+    glBindVertexArray(0);
+}
+
+void SpriteBatch::shutdown()
+{
+
+    if (vbo != 0)
+    {
+        glDeleteBuffers(1, &vbo);
+    }
+    if (vao != 0)
+    {
+        glDeleteVertexArrays(1, &vao);
+    }
+    if (program != 0)
+    {
+        glDeleteProgram(program);
+    }
+    vbo = vao = program = 0;
+    capacity = 0;
+}
+
+void SpriteBatch::clear()
+{
+
+    for (std::vector<Sprite> &sprites : layers)
+    {
+        sprites.clear();
+    }
+}
+
+std::size_t SpriteBatch::spriteCount() const
+{
+
+    std::size_t count = 0;
+    for (const std::vector<Sprite> &sprites : layers)
+    {
+        count += sprites.size();
+    }
+    return count;
+}
+
+void SpriteBatch::pointAttributes(std::size_t first_sprite)
+{
+
+    // GL 3.3 has no base-instance draws, so each layer re-points the attributes at its own run of the buffer.
+    const std::size_t base = first_sprite * sizeof(Sprite);
+    const auto offset = [base](std::size_t member) { return reinterpret_cast<const void *>(base + member); };
+
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Sprite), offset(offsetof(Sprite, x)));
+    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(Sprite), offset(offsetof(Sprite, rotation)));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Sprite), offset(offsetof(Sprite, u0)));
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Sprite), offset(offsetof(Sprite, color)));
+}
+
+void SpriteBatch::bind(GLuint texture, const float view[4])
+{
+
+    glUseProgram(program);
+    glUniform4fv(view_location, 1, view);
+    glUniform1i(texture_location, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glBindVertexArray(vao);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+}
+
+void SpriteBatch::drawBuffer(GLuint buffer, std::size_t count)
+{
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    pointAttributes(0);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count));
+}
+
+void SpriteBatch::draw(GLuint texture, const float view[4])
+{
+
+    draw_calls = 0;
+
+    const std::size_t total = spriteCount();
+    if (total == 0)
+    {
+        return;
+    }
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    // Orphan the old storage (the GPU may still be reading it) and refill fresh storage of the same size. Grows
+    // by doubling, so a steady sprite count settles on one size.
+    if (total > capacity)
+    {
+        capacity = std::max<std::size_t>(1024, capacity);
+        while (capacity < total)
+        {
+            capacity *= 2;
+        }
+    }
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(Sprite), nullptr, GL_STREAM_DRAW);
+
+    std::size_t first = 0;
+    for (const std::vector<Sprite> &sprites : layers)
+    {
+        if (!sprites.empty())
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(Sprite), sprites.size() * sizeof(Sprite), sprites.data());
+            first += sprites.size();
+        }
+    }
+
+    bind(texture, view);
+
+    first = 0;
+    for (const std::vector<Sprite> &sprites : layers)
+    {
+        if (sprites.empty())
+        {
+            continue;
+        }
+
+        pointAttributes(first);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(sprites.size()));
+        first += sprites.size();
+        ++draw_calls;
+    }
+
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
@@ -0,0 +1,197 @@
+#include "texture_atlas.hpp"
+
+#include <png.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// ImGui ships stb_rect_pack but keeps its copy static to imgui_draw.cpp, so compile our own (also static).
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+namespace {
+
+constexpr int padding = 2;           // Texels around each image, filled with its edge, so linear filtering can't
+                                     // pick up a neighbour
+constexpr int max_atlas_size = 4096; // Every GL 3.3 implementation supports at least this
+
+} // namespace
+
+TextureAtlas::Image TextureAtlas::readPng(const std::string &path)
+{
+
+    png_image png;
+    std::memset(&png, 0, sizeof(png));
+    png.version = PNG_IMAGE_VERSION;
+
+    if (!png_image_begin_read_from_file(&png, path.c_str()))
+    {
+        throw std::runtime_error("Failed to open " + path + ": " + png.message);
+    }
+
+    png.format = PNG_FORMAT_RGBA;
+
+    Image image;
+    image.width = static_cast<int>(png.width);
+    image.height = static_cast<int>(png.height);
+    image.rgba.resize(PNG_IMAGE_SIZE(png));
+
+    if (!png_image_finish_read(&png, nullptr, image.rgba.data(), 0, nullptr))
+    {
+        const std::string message = png.message;
+        png_image_free(&png);
+        throw std::runtime_error("Failed to decode " + path + ": " + message);
+    }
+
+    return image;
+}
+
+TextureAtlas::Image TextureAtlas::shrink(const Image &image, int max_size)
+{
+
+    if (image.width <= max_size && image.height <= max_size)
+    {
+        return image;
+    }
+
+    const float scale = static_cast<float>(max_size) / std::max(image.width, image.height);
+
+    Image small;
+    small.width = std::max(1, static_cast<int>(image.width * scale));
+    small.height = std::max(1, static_cast<int>(image.height * scale));
+    small.rgba.resize(std::size_t(small.width) * small.height * 4);
+
+    // Box filter: each output texel averages the source texels it covers. Colour is weighted by alpha so
+    // transparent texels don't darken the edges.
+    for (int y = 0; y < small.height; ++y)
+    {
+        const int y0 = y * image.height / small.height;
+        const int y1 = std::max(y0 + 1, (y + 1) * image.height / small.height);
+
+        for (int x = 0; x < small.width; ++x)
+        {
+            const int x0 = x * image.width / small.width;
+            const int x1 = std::max(x0 + 1, (x + 1) * image.width / small.width);
+
+            float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (int sy = y0; sy < y1; ++sy)
+            {
+                for (int sx = x0; sx < x1; ++sx)
+                {
+                    const std::uint8_t *texel = &image.rgba[(std::size_t(sy) * image.width + sx) * 4];
+                    const float alpha = texel[3];
+                    sum[0] += texel[0] * alpha;
+                    sum[1] += texel[1] * alpha;
+                    sum[2] += texel[2] * alpha;
+                    sum[3] += alpha;
+                }
+            }
+
+            std::uint8_t *out = &small.rgba[(std::size_t(y) * small.width + x) * 4];
+            const float count = static_cast<float>((y1 - y0) * (x1 - x0));
+            for (int c = 0; c < 3; ++c)
+            {
+                out[c] = sum[3] > 0.0f ? static_cast<std::uint8_t>(sum[c] / sum[3] + 0.5f) : 0;
+            }
+            out[3] = static_cast<std::uint8_t>(sum[3] / count + 0.5f);
+        }
+    }
+
+    return small;
+}
+
+void TextureAtlas::load(const std::string &directory, const std::vector<std::string> &names, int max_image_size)
+{
+
+    std::vector<Image> images;
+    images.reserve(names.size() + 1);
+    for (const std::string &name : names)
+    {
+        images.push_back(shrink(readPng(directory + "/" + name + ".png"), max_image_size));
+    }
+
+    // Plus a small white square for untextured quads (health bars and the like).
+    Image solid;
+    solid.width = solid.height = 4;
+    solid.rgba.assign(4 * 4 * 4, 255);
+    images.push_back(std::move(solid));
+
+    std::vector<stbrp_rect> rects(images.size());
+    for (std::size_t i = 0; i < images.size(); ++i)
+    {
+        rects[i].id = static_cast<int>(i);
+        rects[i].w = images[i].width + 2 * padding;
+        rects[i].h = images[i].height + 2 * padding;
+    }
+
+    // Smallest power-of-two square that takes everything.
+    int size = 64;
+    for (;; size *= 2)
+    {
+        if (size > max_atlas_size)
+        {
+            throw std::runtime_error("Textures don't fit in a " + std::to_string(max_atlas_size) + " atlas");
+        }
+
+        std::vector<stbrp_node> nodes(size);
+        stbrp_context context;
+        stbrp_init_target(&context, size, size, nodes.data(), static_cast<int>(nodes.size()));
+        if (stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size())))
+        {
+            break;
+        }
+    }
+
+    std::vector<std::uint8_t> pixels(std::size_t(size) * size * 4, 0);
+    std::vector<Region> packed(images.size());
+
+    for (const stbrp_rect &rect : rects)
+    {
+        const Image &image = images[rect.id];
+
+        // Copy with the edge texels smeared out into the padding.
+        for (int y = -padding; y < image.height + padding; ++y)
+        {
+            const int sy = std::clamp(y, 0, image.height - 1);
+            for (int x = -padding; x < image.width + padding; ++x)
+            {
+                const int sx = std::clamp(x, 0, image.width - 1);
+                const std::size_t dst = (std::size_t(rect.y + padding + y) * size + rect.x + padding + x) * 4;
+                std::memcpy(&pixels[dst], &image.rgba[(std::size_t(sy) * image.width + sx) * 4], 4);
+            }
+        }
+
+        const float inv = 1.0f / size;
+        packed[rect.id] = {(rect.x + padding) * inv, (rect.y + padding) * inv, (rect.x + padding + image.width) * inv,
+                           (rect.y + padding + image.height) * inv};
+    }
+
+    shutdown();
+
+    glGenTextures(1, &texture_id);
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    atlas_width = atlas_height = size;
+    white = packed.back();
+    packed.pop_back();
+    regions = std::move(packed);
+}
+
+void TextureAtlas::shutdown()
+{
+
+    if (texture_id != 0)
+    {
+        glDeleteTextures(1, &texture_id);
+        texture_id = 0;
+    }
+}
@@ -0,0 +1,138 @@
+#include "tilemap.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void Tilemap::shutdown()
+{
+
+    for (Chunk &chunk : chunks)
+    {
+        if (chunk.vbo != 0)
+        {
+            glDeleteBuffers(1, &chunk.vbo);
+        }
+    }
+    chunks.clear();
+}
+
+void Tilemap::reset(int width, int height, float tile_size, float origin_x, float origin_y)
+{
+
+    shutdown();
+
+    this->width = std::max(0, width);
+    this->height = std::max(0, height);
+    this->tile_size = tile_size;
+    this->origin_x = origin_x;
+    this->origin_y = origin_y;
+
+    tiles.assign(std::size_t(this->width) * this->height, empty);
+    chunks_x = (this->width + chunk_tiles - 1) / chunk_tiles;
+    chunks_y = (this->height + chunk_tiles - 1) / chunk_tiles;
+    chunks.assign(std::size_t(chunks_x) * chunks_y, Chunk{});
+}
+
+void Tilemap::setTileRegion(std::uint8_t tile, const TextureAtlas::Region &region)
+{
+
+    if (regions.size() <= tile)
+    {
+        regions.resize(tile + 1, TextureAtlas::Region{});
+    }
+    regions[tile] = region;
+
+    for (Chunk &chunk : chunks)
+    {
+        chunk.dirty = true;
+    }
+}
+
+void Tilemap::setTile(int x, int y, std::uint8_t tile)
+{
+
+    std::uint8_t &slot = tiles[std::size_t(y) * width + x];
+    if (slot != tile)
+    {
+        slot = tile;
+        chunks[std::size_t(y / chunk_tiles) * chunks_x + x / chunk_tiles].dirty = true;
+    }
+}
+
+void Tilemap::rebuild(int chunk_x, int chunk_y, Chunk &chunk)
+{
+
+    scratch.clear();
+
+    const int x0 = chunk_x * chunk_tiles, x1 = std::min(width, x0 + chunk_tiles);
+    const int y0 = chunk_y * chunk_tiles, y1 = std::min(height, y0 + chunk_tiles);
+    for (int y = y0; y < y1; ++y)
+    {
+        for (int x = x0; x < x1; ++x)
+        {
+            const std::uint8_t id = tile(x, y);
+            if (id == empty || id >= regions.size())
+            {
+                continue;
+            }
+
+            const TextureAtlas::Region &region = regions[id];
+            scratch.push_back({origin_x + x * tile_size, origin_y - y * tile_size, tile_size, tile_size, 0.0f,
+                               region.u0, region.v0, region.u1, region.v1, SpriteBatch::rgba(255, 255, 255)});
+        }
+    }
+
+    if (chunk.vbo == 0)
+    {
+        glGenBuffers(1, &chunk.vbo);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+    glBufferData(GL_ARRAY_BUFFER, scratch.size() * sizeof(Sprite), scratch.data(), GL_STATIC_DRAW);
+
+    chunk.sprite_count = scratch.size();
+    chunk.dirty = false;
+}
+
+void Tilemap::draw(SpriteBatch &batch, float min_x, float min_y, float max_x, float max_y)
+{
+
+    chunks_drawn = 0;
+    chunks_uploaded = 0;
+    if (chunks.empty())
+    {
+        return;
+    }
+
+    // Visible tile range (half a tile of slack, since tiles are centred on their coordinates), then chunk range.
+    const float inv = 1.0f / tile_size;
+    const int tx0 = static_cast<int>(std::floor((min_x - origin_x) * inv + 0.5f));
+    const int tx1 = static_cast<int>(std::floor((max_x - origin_x) * inv + 0.5f));
+    const int ty0 = static_cast<int>(std::floor((origin_y - max_y) * inv + 0.5f));
+    const int ty1 = static_cast<int>(std::floor((origin_y - min_y) * inv + 0.5f));
+    if (tx1 < 0 || ty1 < 0 || tx0 >= width || ty0 >= height)
+    {
+        return;
+    }
+
+    const int cx0 = std::max(0, tx0) / chunk_tiles, cx1 = std::min(width - 1, tx1) / chunk_tiles;
+    const int cy0 = std::max(0, ty0) / chunk_tiles, cy1 = std::min(height - 1, ty1) / chunk_tiles;
+
+    for (int cy = cy0; cy <= cy1; ++cy)
+    {
+        for (int cx = cx0; cx <= cx1; ++cx)
+        {
+            Chunk &chunk = chunks[std::size_t(cy) * chunks_x + cx];
+            if (chunk.dirty)
+            {
+                rebuild(cx, cy, chunk);
+                ++chunks_uploaded;
+            }
+
+            if (chunk.sprite_count > 0)
+            {
+                batch.drawBuffer(chunk.vbo, chunk.sprite_count);
+                ++chunks_drawn;
+            }
+        }
+    }
+}
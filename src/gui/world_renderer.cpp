@@ -0,0 +1,206 @@
+#include "world_renderer.hpp"
+
+#include "sim/simulation_thread.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Order matches the names handed to the atlas.
+enum SpriteImage : std::size_t { Ant, Dirt, Grass, Sawblade };
+
+enum TerrainTile : std::uint8_t { NoTile = Tilemap::empty, GrassTile, DirtTile };
+
+constexpr float tile_size = 4.0f;  // Ground tiles (roughly - arenas hold a whole number of them), world units
+constexpr float agent_size = 1.6f; // Ant sprite edge
+constexpr float boss_size = 4.0f;
+constexpr float half_pi = 1.5707963f;
+
+// Cheap integer hash, so the ground pattern is fixed without storing it.
+std::uint32_t tileHash(int x, int y)
+{
+
+    std::uint32_t h = static_cast<std::uint32_t>(x) * 0x8da6b343u ^ static_cast<std::uint32_t>(y) * 0xd8163841u;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    return h ^ (h >> 15);
+}
+
+} // namespace
+
+WorldRenderer::WorldRenderer() : batch(layer_count) {}
+
+void WorldRenderer::init(const std::string &texture_dir)
+{
+
+    atlas.load(texture_dir, {"ant", "dirt", "grass", "sawblade"});
+    batch.init();
+
+    terrain.setTileRegion(GrassTile, atlas.region(Grass));
+    terrain.setTileRegion(DirtTile, atlas.region(Dirt));
+}
+
+void WorldRenderer::shutdown()
+{
+
+    terrain.shutdown();
+    batch.shutdown();
+    atlas.shutdown();
+}
+
+WorldRenderer::Layout WorldRenderer::layoutFor(const sim::WorldFrame &frame)
+{
+
+    Layout layout;
+    const double side = std::ceil(std::sqrt(static_cast<double>(frame.instance_count)));
+    layout.columns = std::max<std::size_t>(1, static_cast<std::size_t>(side));
+    layout.rows = (frame.instance_count + layout.columns - 1) / layout.columns;
+    layout.tiles = std::max(1, static_cast<int>(std::lround(2.0f * frame.arena_half_size / tile_size)));
+    layout.tile_size = 2.0f * frame.arena_half_size / layout.tiles;
+    layout.pitch = (layout.tiles + 1) * layout.tile_size;
+    return layout;
+}
+
+void WorldRenderer::arenaCentre(std::size_t instance, float &x, float &y) const
+{
+
+    x = static_cast<float>(instance % layout.columns) * layout.pitch;
+    y = -static_cast<float>(instance / layout.columns) * layout.pitch;
+}
+
+void WorldRenderer::render(const sim::WorldFrame &frame, int width, int height)
+{
+
+    batch.clear();
+    sprite_count = 0;
+    if (frame.instance_count == 0 || width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    updateTerrain(frame);
+    addEncounters(frame);
+
+    // Fit the whole grid of arenas, keeping world units square.
+    const float world_w = layout.columns * layout.pitch;
+    const float world_h = layout.rows * layout.pitch;
+    const float centre_x = 0.5f * (layout.columns - 1) * layout.pitch;
+    const float centre_y = -0.5f * (layout.rows - 1) * layout.pitch;
+
+    const float pixels_per_unit = std::min(width / world_w, height / world_h);
+    const float scale_x = 2.0f * pixels_per_unit / width;
+    const float scale_y = 2.0f * pixels_per_unit / height;
+    const float view[4] = {scale_x, scale_y, -centre_x * scale_x, -centre_y * scale_y};
+
+    // Ground first, straight from the cached chunks, then everything that moves on top.
+    batch.bind(atlas.texture(), view);
+    terrain.draw(batch, (-1.0f - view[2]) / view[0], (-1.0f - view[3]) / view[1], (1.0f - view[2]) / view[0],
+                 (1.0f - view[3]) / view[1]);
+    batch.draw(atlas.texture(), view);
+
+    sprite_count = batch.spriteCount();
+}
+
+void WorldRenderer::updateTerrain(const sim::WorldFrame &frame)
+{
+
+    if (frame.instance_count == terrain_instances && frame.arena_half_size == terrain_half_size)
+    {
+        return;
+    }
+    terrain_instances = frame.instance_count;
+    terrain_half_size = frame.arena_half_size;
+    layout = layoutFor(frame);
+
+    // One map over every arena, with an empty row and column of tiles between neighbours.
+    const int span = layout.tiles + 1;
+    const float half = frame.arena_half_size;
+    const float first_centre = -half + 0.5f * layout.tile_size;
+    terrain.reset(static_cast<int>(layout.columns) * span, static_cast<int>(layout.rows) * span, layout.tile_size,
+                  first_centre, -first_centre);
+
+    for (std::size_t i = 0; i < frame.instance_count; ++i)
+    {
+        const int base_x = static_cast<int>(i % layout.columns) * span;
+        const int base_y = static_cast<int>(i / layout.columns) * span;
+
+        for (int ty = 0; ty < layout.tiles; ++ty)
+        {
+            for (int tx = 0; tx < layout.tiles; ++tx)
+            {
+                // Trampled dirt in the middle where the boss stands, with a ragged edge.
+                const float x = first_centre + tx * layout.tile_size;
+                const float y = first_centre + ty * layout.tile_size;
+                const float ragged = static_cast<float>(tileHash(tx, ty) % 100) * 0.04f;
+                const bool worn = std::sqrt(x * x + y * y) < 0.4f * half + ragged;
+
+                terrain.setTile(base_x + tx, base_y + ty, worn ? DirtTile : GrassTile);
+            }
+        }
+    }
+}
+
+void WorldRenderer::addEncounters(const sim::WorldFrame &frame)
+{
+
+    const TextureAtlas::Region &ant = atlas.region(Ant);
+    const TextureAtlas::Region &saw = atlas.region(Sawblade);
+
+    static const std::uint32_t role_colors[3] = {
+        SpriteBatch::rgba(90, 140, 255), // Tank
+        SpriteBatch::rgba(90, 230, 120), // Healer
+        SpriteBatch::rgba(255, 210, 80), // DPS
+    };
+    const std::uint32_t dead_color = SpriteBatch::rgba(120, 120, 120, 90);
+
+    for (std::size_t i = 0; i < frame.instance_count; ++i)
+    {
+        float cx, cy;
+        arenaCentre(i, cx, cy);
+
+        if (frame.aoe_timer[i] > 0.0f)
+        {
+            const float diameter = 2.0f * frame.aoe_radius;
+            batch.add(Markers, {cx + frame.aoe_x[i], cy + frame.aoe_y[i], diameter, diameter, frame.tick * 0.15f,
+                                saw.u0, saw.v0, saw.u1, saw.v1, SpriteBatch::rgba(255, 120, 120, 170)});
+        }
+
+        const std::size_t first = i * frame.party_size;
+        for (std::size_t a = first; a < first + frame.party_size; ++a)
+        {
+            const bool alive = frame.health[a] > 0.0f;
+            const float x = cx + frame.x[a];
+            const float y = cy + frame.y[a];
+
+            // The ant sprite faces up, headings are measured from +x.
+            batch.add(Units, {x, y, agent_size, agent_size, frame.heading[a] - half_pi, ant.u0, ant.v0, ant.u1, ant.v1,
+                              alive ? role_colors[static_cast<int>(frame.role[a])] : dead_color});
+
+            if (alive && frame.health[a] < 1.0f)
+            {
+                addBar(x, y + 0.7f * agent_size, agent_size, frame.health[a], SpriteBatch::rgba(80, 220, 80));
+            }
+        }
+
+        const float bx = cx + frame.boss_x[i];
+        const float by = cy + frame.boss_y[i];
+        const bool boss_alive = frame.boss_health[i] > 0.0f;
+        batch.add(Units, {bx, by, boss_size, boss_size, 0.0f, ant.u0, ant.v0, ant.u1, ant.v1,
+                          boss_alive ? SpriteBatch::rgba(230, 60, 60) : dead_color});
+        addBar(bx, by + 0.7f * boss_size, 1.5f * boss_size, frame.boss_health[i], SpriteBatch::rgba(230, 60, 60));
+    }
+}
+
+void WorldRenderer::addBar(float x, float y, float width, float fraction, std::uint32_t color)
+{
+
+    const TextureAtlas::Region &white = atlas.whiteRegion();
+    const float height = 0.25f;
+    fraction = std::clamp(fraction, 0.0f, 1.0f);
+
+    batch.add(Bars, {x, y, width, height, 0.0f, white.u0, white.v0, white.u1, white.v1,
+                     SpriteBatch::rgba(20, 20, 20, 200)});
+    batch.add(Bars, {x - 0.5f * width * (1.0f - fraction), y, width * fraction, height, 0.0f, white.u0, white.v0,
+                     white.u1, white.v1, color});
+}
@@ -0,0 +1,116 @@
+#include "world_view.hpp"
+
+#include "sim/simulation_thread.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+void WorldView::init(const std::string &texture_dir)
+{
+
+    renderer.init(texture_dir);
+    glGenFramebuffers(1, &framebuffer);
+}
+
+void WorldView::shutdown()
+{
+
+    if (color_texture != 0)
+    {
+        glDeleteTextures(1, &color_texture);
+        color_texture = 0;
+    }
+    if (framebuffer != 0)
+    {
+        glDeleteFramebuffers(1, &framebuffer);
+        framebuffer = 0;
+    }
+    target_width = target_height = 0;
+    renderer.shutdown();
+}
+
+void WorldView::requestFrame(int width, int height)
+{
+
+    requested_width = width;
+    requested_height = height;
+    requested = true;
+}
+
+void WorldView::resizeTarget(int width, int height)
+{
+
+    if (color_texture == 0)
+    {
+        glGenTextures(1, &color_texture);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, color_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); // Upscaled when below window resolution
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_texture, 0);
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        throw std::runtime_error("World framebuffer is incomplete");
+    }
+
+    target_width = width;
+    target_height = height;
+}
+
+void WorldView::render(const sim::WorldFrame &frame)
+{
+
+    if (!requested)
+    {
+        return; // Window hidden (or docked behind another tab) - nothing to draw for
+    }
+    requested = false;
+
+    const float scale = std::clamp(resolution_scale, 0.1f, 1.0f);
+    const int width = std::max(1, static_cast<int>(std::lround(requested_width * scale)));
+    const int height = std::max(1, static_cast<int>(std::lround(requested_height * scale)));
+    const bool resized = width != target_width || height != target_height;
+
+    // A resize always redraws (the old texture is gone). Otherwise only when the sim has moved on and the rate
+    // cap allows it; a paused run costs nothing.
+    const auto now = Clock::now();
+    const bool moved = frame.generation != last_generation || frame.tick != last_tick;
+    const bool due = max_fps <= 0.0f || now - last_render >= std::chrono::duration<double>(1.0 / max_fps);
+    if (!resized && !(moved && due))
+    {
+        return;
+    }
+
+    if (resized)
+    {
+        resizeTarget(width, height);
+    }
+
+    GLfloat clear_color[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clear_color);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+    glClearColor(0.08f, 0.08f, 0.08f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    renderer.render(frame, width, height);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glClearColor(clear_color[0], clear_color[1], clear_color[2], clear_color[3]);
+
+    last_render = now;
+    last_generation = frame.generation;
+    last_tick = frame.tick;
+}
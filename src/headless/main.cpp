@@ -0,0 +1,288 @@
+// Headless runner (neat_sim) - drives evolution with no SDL, GL or ImGui.
+// Nothing here waits on a display, so generations per second are bounded by the CPU only.
+
+#include "neat_core/checkpoint.hpp"
+#include "neat_core/checkpoint_writer.hpp"
+#include "neat_core/trace_writer.hpp"
+#include "sim/simulation.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct RunOptions {
+    std::uint64_t generations = 0; // 0 = run until interrupted
+    std::uint64_t report_every = 100;
+    std::string checkpoint_path;        // Empty = no checkpoints
+    std::uint64_t checkpoint_every = 0; // 0 = only when the run ends
+    std::string resume_path;
+    std::string trace_path; // Empty = no trace
+    sim::SimulationConfig simulation;
+};
+
+std::atomic<bool> interrupted{false};
+
+void onSignal(int) { interrupted = true; }
+
+void printUsage(const char *exe)
+{
+
+    std::cout << "Usage: " << exe << " [options]\n"
+              << "  --task NAME       encounter (boss fight, default) or xor\n"
+              << "  --generations N   Stop after N generations (default: run until Ctrl-C)\n"
+              << "  --population N    Individuals per generation (default: 150)\n"
+              << "  --seed N          Run seed (default: 1)\n"
+              << "  --encounter-ticks N  Longest an evaluation encounter runs before it counts as a wipe\n"
+              << "                    (default: 1800, 30 s at 60 Hz)\n"
+              << "  --threads N       Fitness evaluation threads (default: one per core)\n"
+              << "  --report-every N  Print progress every N generations (default: 100)\n"
+              << "  --checkpoint PATH Save the population to PATH when the run ends\n"
+              << "  --checkpoint-every N  Also save every N generations\n"
+              << "  --resume PATH     Carry on from a checkpoint instead of starting fresh\n"
+              << "  --trace PATH      Write a Chrome trace (chrome://tracing, ui.perfetto.dev) of the run to PATH\n";
+}
+
+// Returns false if the arguments were bad (or --help was asked for) and the program should exit.
+bool parseArgs(int argc, char **argv, RunOptions &options)
+{
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+        {
+            printUsage(argv[0]);
+            return false;
+        }
+        else if (std::strcmp(arg, "--task") == 0 && has_value)
+        {
+            const char *task = argv[++i];
+            if (std::strcmp(task, "encounter") == 0)
+            {
+                options.simulation.task = sim::Task::Encounter;
+            }
+            else if (std::strcmp(task, "xor") == 0)
+            {
+                options.simulation.task = sim::Task::Xor;
+            }
+            else
+            {
+                std::cerr << "Unknown task: " << task << std::endl;
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--generations") == 0 && has_value)
+        {
+            options.generations = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--population") == 0 && has_value)
+        {
+            options.simulation.population.size = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--seed") == 0 && has_value)
+        {
+            options.simulation.population.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--encounter-ticks") == 0 && has_value)
+        {
+            options.simulation.encounter.max_ticks = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(arg, "--threads") == 0 && has_value)
+        {
+            options.simulation.threads = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--report-every") == 0 && has_value)
+        {
+            options.report_every = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--checkpoint") == 0 && has_value)
+        {
+            options.checkpoint_path = argv[++i];
+        }
+        else if (std::strcmp(arg, "--checkpoint-every") == 0 && has_value)
+        {
+            options.checkpoint_every = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--resume") == 0 && has_value)
+        {
+            options.resume_path = argv[++i];
+        }
+        else if (std::strcmp(arg, "--trace") == 0 && has_value)
+        {
+            options.trace_path = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Unknown or incomplete argument: " << arg << std::endl;
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+
+    RunOptions options;
+    if (!parseArgs(argc, argv, options))
+    {
+        return 1;
+    }
+
+    // Ctrl-C finishes the current generation and prints a summary instead of killing the run mid-epoch.
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    // Ticks between generations only pace the GUI's showcase, and there is none here: breed on every tick.
+    options.simulation.showcase_ticks = 1;
+
+    // Started first so the trace covers loading too. Everything is timed by the NEAT_PROFILE_SCOPE points.
+    neat::Profiler::setThreadName("main");
+    std::unique_ptr<neat::TraceWriter> trace;
+    if (!options.trace_path.empty())
+    {
+#if !NEAT_PROFILER
+        std::cerr << "Built with NEAT_PROFILER off - the trace will be empty" << std::endl;
+#endif
+        try
+        {
+            trace = std::make_unique<neat::TraceWriter>(options.trace_path);
+        }
+        catch (const std::runtime_error &e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    sim::Simulation simulation(options.simulation);
+    const neat::Population &population = simulation.getPopulation();
+
+    if (!options.resume_path.empty())
+    {
+        try
+        {
+            NEAT_PROFILE_SCOPE("load checkpoint");
+            const auto load_start = std::chrono::steady_clock::now();
+            neat::MappedCheckpoint checkpoint(options.resume_path);
+            simulation.restore(checkpoint.view());
+
+            const double ms =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load_start).count();
+            std::cout << "Resumed " << population.size() << " genomes at generation " << population.generation()
+                      << " in " << ms << " ms" << std::endl;
+        }
+        catch (const std::runtime_error &e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Checkpoints are written on a background thread, so saving often doesn't slow the run down.
+    neat::CheckpointWriter checkpoints;
+    bool saved_any = false;
+    std::uint64_t last_saved_generation = 0;
+    auto saveCheckpoint = [&]() {
+        if (!options.checkpoint_path.empty())
+        {
+            checkpoints.submit(population.snapshot(), options.checkpoint_path);
+            last_saved_generation = population.generation();
+            saved_any = true;
+        }
+    };
+
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    auto last_report = start;
+    const std::uint64_t first_generation = population.generation();
+    std::uint64_t last_report_generation = first_generation;
+
+    while (!interrupted && (options.generations == 0 || population.generation() < options.generations))
+    {
+        // No clock here - every tick scores and breeds a whole generation, back to back as fast as the CPU allows.
+        const std::uint64_t generation = population.generation();
+        simulation.tick();
+
+        if (population.generation() != generation && options.report_every != 0 &&
+            population.generation() % options.report_every == 0)
+        {
+            const auto now = Clock::now();
+            const double seconds = std::chrono::duration<double>(now - last_report).count();
+            const double rate = (population.generation() - last_report_generation) / seconds;
+
+            std::cout << "gen " << population.generation() << "  best " << population.bestFitness() << "  species "
+                      << population.getSpecies().size() << "  " << rate << " gen/s  genes "
+                      << population.geneBytesReserved() / 1024 << " KiB" << std::endl;
+
+            last_report = now;
+            last_report_generation = population.generation();
+        }
+
+        if (population.generation() != generation && options.checkpoint_every != 0 &&
+            population.generation() % options.checkpoint_every == 0)
+        {
+            saveCheckpoint();
+        }
+    }
+
+    const double total_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const std::uint64_t generations_run = population.generation() - first_generation;
+    std::cout << "Finished " << generations_run << " generations in " << total_seconds << " s ("
+              << generations_run / total_seconds << " gen/s)" << std::endl;
+
+    // Unless --checkpoint-every just saved this very generation.
+    if (!saved_any || last_saved_generation != population.generation())
+    {
+        saveCheckpoint();
+    }
+    {
+        NEAT_PROFILE_SCOPE("checkpoint flush");
+        checkpoints.flush();
+    }
+
+    if (trace)
+    {
+        trace->finish();
+        std::cout << "Trace: " << trace->eventsWritten() << " events written to " << trace->getPath() << ", "
+                  << trace->dropped() << " dropped" << std::endl;
+
+        if (!trace->lastError().empty())
+        {
+            std::cerr << trace->lastError() << std::endl;
+            return 1;
+        }
+    }
+
+    if (!options.checkpoint_path.empty())
+    {
+        std::cout << "Checkpoints: " << checkpoints.written() << " written, " << checkpoints.dropped()
+                  << " superseded before writing" << std::endl;
+
+        if (!checkpoints.lastWarning().empty())
+        {
+            std::cerr << checkpoints.lastWarning() << std::endl;
+        }
+        if (!checkpoints.lastError().empty())
+        {
+            std::cerr << checkpoints.lastError() << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -1,6 +1,10 @@
+#include "frame_limiter.hpp"
 #include "glad/gl.h"
 #include "imguihandler.h"
+#include "neat_core/profiler.hpp"
 #include "sdl_handler.hpp"
+#include "sim/simulation_thread.hpp"
+#include "world_view.hpp"
 #include <SDL.h>
 #include <stdexcept>
 
@@ -15,23 +19,49 @@ int main() {
         throw std::runtime_error("Failed to load OpenGL with glad");
     }
 
-    // Enable vsync
-    SDL_GL_SetSwapInterval(1);
+    // Vsync off - the frame limiter paces rendering instead.
+    SDL_GL_SetSwapInterval(0);
+
+    // Simulation runs on its own thread and fixed timestep, decoupled from how often we draw.
+    // The showcase replays each generation tick by tick, giving the world view something to draw.
+    sim::SimulationConfig sim_config;
+    sim_config.showcase = true;
+    sim::SimulationThread sim_thread(sim_config);
+    sim_thread.start();
+    FrameLimiter frame_limiter(60.0);
 
     // ImGui Initialisation
     ImGuiHandler imguihandler;
     imguihandler.Init(sdl_handler.getWindow(), sdl_handler.getGLContext(), "#version 330 core");
+    imguihandler.setSimulation(&sim_thread);
+
+    WorldView world_view;
+    world_view.init(TEXTURE_DIR);
+    imguihandler.setWorldView(&world_view);
 
     bool first_update = true; // Flag for first ImGui update().
 
+    neat::Profiler::setThreadName("ui");
+
     // Main loop
     while (sdl_handler.running()) {
 
+        NEAT_PROFILE_SCOPE("frame");
+
         sdl_handler.handle_events(); // Listen for user events to interrupt loop when window is exited.
 
-        imguihandler.NewFrame();
-        imguihandler.Update(first_update);
-        first_update = false;
+        {
+            NEAT_PROFILE_SCOPE("ImGui update");
+            imguihandler.NewFrame();
+            imguihandler.Update(first_update);
+            first_update = false;
+        }
+
+        // Off-screen, into the texture the World window shows. Skipped when the window is hidden or not due.
+        {
+            NEAT_PROFILE_SCOPE("world render");
+            world_view.render(sim_thread.latestWorld());
+        }
 
         // Handling screen before rendering - should make cleaner.
         int screen_w, screen_h;
@@ -40,12 +70,18 @@ int main() {
         glClear(GL_COLOR_BUFFER_BIT); // Clearing screen to remove 'ghosting'
 
 
-        imguihandler.Render();
+        {
+            NEAT_PROFILE_SCOPE("ImGui render");
+            imguihandler.Render();
+            SDL_GL_SwapWindow(sdl_handler.getWindow());
+        }
 
-        SDL_GL_SwapWindow(sdl_handler.getWindow());
+        frame_limiter.wait();
     }
 
     // Clean up
+    sim_thread.stop();
+    world_view.shutdown();
     imguihandler.Shutdown();
     sdl_handler.clean();
 
@@ -0,0 +1,64 @@
+#include "neat_core/arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace neat {
+
+namespace {
+
+std::size_t alignUp(std::uintptr_t address, std::size_t alignment)
+{
+    return static_cast<std::size_t>((address + alignment - 1) & ~(std::uintptr_t(alignment) - 1));
+}
+
+} // namespace
+
+Arena::Arena(std::size_t block_size) : block_size(block_size) {}
+
+void Arena::reset()
+{
+
+    current = 0;
+    offset = 0;
+    used = 0;
+}
+
+bool Arena::fitsInBlock(std::size_t block, std::size_t bytes, std::size_t alignment) const
+{
+
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(blocks[block].data.get());
+    const std::size_t start = alignUp(base + offset, alignment) - base;
+    return start + bytes <= blocks[block].size;
+}
+
+void *Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+
+    // Move along the kept blocks until one has room. Anything skipped is wasted until the next reset, which is
+    // fine - blocks are big compared to any one gene array.
+    while (current < blocks.size() && !fitsInBlock(current, bytes, alignment))
+    {
+        ++current;
+        offset = 0;
+    }
+
+    if (current == blocks.size())
+    {
+        // Oversized requests get a block of their own rather than failing.
+        const std::size_t size = std::max(block_size, bytes + alignment);
+        blocks.push_back(Block{std::make_unique<std::byte[]>(size), size});
+        reserved += size;
+        offset = 0;
+    }
+
+    std::byte *base = blocks[current].data.get();
+    const std::size_t start = alignUp(reinterpret_cast<std::uintptr_t>(base) + offset, alignment) -
+                              reinterpret_cast<std::uintptr_t>(base);
+
+    offset = start + bytes;
+    used += bytes;
+    return base + start;
+}
+
+} // namespace neat
@@ -0,0 +1,383 @@
+#include "neat_core/batch_network.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NEAT_BATCH_SSE2 1
+#endif
+
+namespace neat {
+
+namespace {
+
+constexpr std::size_t lanes = NetworkBatch::lanes;
+
+// Vec8 - eight float lanes, whatever the target gives us. Each flavour provides the same handful of operations.
+// Exponentials use the Cephes polynomial (what avx_mathfun/sse_mathfun use), good to ~1e-7 relative.
+
+#if defined(__AVX2__)
+
+struct Vec8 {
+    __m256 v;
+};
+
+inline Vec8 load(const float *p) { return {_mm256_loadu_ps(p)}; }
+inline void store(float *p, Vec8 a) { _mm256_storeu_ps(p, a.v); }
+inline Vec8 zero() { return {_mm256_setzero_ps()}; }
+
+inline Vec8 multiplyAdd(Vec8 a, Vec8 b, Vec8 c)
+{
+#if defined(__FMA__)
+    return {_mm256_fmadd_ps(a.v, b.v, c.v)};
+#else
+    return {_mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v)};
+#endif
+}
+
+inline __m256 exp8(__m256 x)
+{
+    x = _mm256_min_ps(x, _mm256_set1_ps(88.3762626647949f));
+    x = _mm256_max_ps(x, _mm256_set1_ps(-88.3762626647949f));
+
+    __m256 fx = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)), _mm256_set1_ps(0.5f));
+    fx = _mm256_floor_ps(fx);
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(0.693359375f)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(-2.12194440e-4f)));
+
+    __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.3981999507e-3f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(8.3334519073e-3f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(4.1665795894e-2f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.6666665459e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(5.0000001201e-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, _mm256_mul_ps(x, x)), _mm256_add_ps(x, _mm256_set1_ps(1.0f)));
+
+    const __m256i exponent =
+        _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(exponent));
+}
+
+inline Vec8 activation(Vec8 sum)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 e = exp8(_mm256_mul_ps(sum.v, _mm256_set1_ps(-4.9f)));
+    return {_mm256_div_ps(one, _mm256_add_ps(one, e))};
+}
+
+#elif defined(NEAT_BATCH_SSE2)
+
+struct Vec8 {
+    __m128 lo;
+    __m128 hi;
+};
+
+inline Vec8 load(const float *p) { return {_mm_loadu_ps(p), _mm_loadu_ps(p + 4)}; }
+inline void store(float *p, Vec8 a)
+{
+    _mm_storeu_ps(p, a.lo);
+    _mm_storeu_ps(p + 4, a.hi);
+}
+inline Vec8 zero() { return {_mm_setzero_ps(), _mm_setzero_ps()}; }
+
+inline Vec8 multiplyAdd(Vec8 a, Vec8 b, Vec8 c)
+{
+    return {_mm_add_ps(_mm_mul_ps(a.lo, b.lo), c.lo), _mm_add_ps(_mm_mul_ps(a.hi, b.hi), c.hi)};
+}
+
+inline __m128 exp4(__m128 x)
+{
+    x = _mm_min_ps(x, _mm_set1_ps(88.3762626647949f));
+    x = _mm_max_ps(x, _mm_set1_ps(-88.3762626647949f));
+
+    // floor() without SSE4.1: truncate, then step down where truncation rounded up
+    __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f));
+    const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+    fx = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, fx), _mm_set1_ps(1.0f)));
+
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+
+    __m128 y = _mm_set1_ps(1.9875691500e-4f);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, _mm_mul_ps(x, x)), _mm_add_ps(x, _mm_set1_ps(1.0f)));
+
+    const __m128i exponent = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(127)), 23);
+    return _mm_mul_ps(y, _mm_castsi128_ps(exponent));
+}
+
+inline __m128 activation4(__m128 sum)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 e = exp4(_mm_mul_ps(sum, _mm_set1_ps(-4.9f)));
+    return _mm_div_ps(one, _mm_add_ps(one, e));
+}
+
+inline Vec8 activation(Vec8 sum) { return {activation4(sum.lo), activation4(sum.hi)}; }
+
+#else
+
+struct Vec8 {
+    float v[lanes];
+};
+
+inline Vec8 load(const float *p)
+{
+    Vec8 a;
+    std::copy(p, p + lanes, a.v);
+    return a;
+}
+inline void store(float *p, Vec8 a) { std::copy(a.v, a.v + lanes, p); }
+inline Vec8 zero() { return Vec8{}; }
+
+inline Vec8 multiplyAdd(Vec8 a, Vec8 b, Vec8 c)
+{
+    for (std::size_t i = 0; i < lanes; ++i)
+    {
+        c.v[i] += a.v[i] * b.v[i];
+    }
+    return c;
+}
+
+inline Vec8 activation(Vec8 sum)
+{
+    for (float &x : sum.v)
+    {
+        x = neuronActivation(x);
+    }
+    return sum;
+}
+
+#endif
+
+} // namespace
+
+bool sameTopology(const Network &a, const Network &b)
+{
+
+    if (a.numInputs() != b.numInputs() || a.numOutputs() != b.numOutputs() || a.valueCount() != b.valueCount() ||
+        a.ops().size() != b.ops().size() || a.edgeSources() != b.edgeSources())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < a.ops().size(); ++i)
+    {
+        const Network::NodeOp &op_a = a.ops()[i];
+        const Network::NodeOp &op_b = b.ops()[i];
+        if (op_a.target != op_b.target || op_a.first_edge != op_b.first_edge || op_a.edge_count != op_b.edge_count)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint64_t topologyHash(const Network &network)
+{
+
+    // FNV-1a over everything sameTopology() compares
+    std::uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](std::uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+
+    mix(network.numInputs());
+    mix(network.numOutputs());
+    mix(network.valueCount());
+    for (const Network::NodeOp &op : network.ops())
+    {
+        mix(op.target);
+        mix(op.edge_count);
+    }
+    for (std::uint32_t source : network.edgeSources())
+    {
+        mix(source);
+    }
+    return hash;
+}
+
+NetworkBatch::NetworkBatch(const Network *const *networks, std::size_t count)
+    : lane_count(count), num_inputs(networks[0]->numInputs()), num_outputs(networks[0]->numOutputs()),
+      node_ops(networks[0]->ops()), edge_source(networks[0]->edgeSources())
+{
+
+    assert(count >= 1 && count <= lanes);
+
+    // Unused lanes keep zero weights; they compute garbage nobody reads.
+    edge_weight.assign(edge_source.size() * lanes, 0.0f);
+    for (std::size_t lane = 0; lane < count; ++lane)
+    {
+        assert(sameTopology(*networks[0], *networks[lane]));
+
+        const std::vector<float> &weights = networks[lane]->edgeWeights();
+        for (std::size_t e = 0; e < weights.size(); ++e)
+        {
+            edge_weight[e * lanes + lane] = weights[e];
+        }
+    }
+
+    values.assign(networks[0]->valueCount() * lanes, 0.0f);
+}
+
+void NetworkBatch::laneActivations(std::size_t lane, float *out) const
+{
+
+    assert(lane < lane_count);
+    const std::size_t count = valueCount();
+    for (std::size_t node = 0; node < count; ++node)
+    {
+        out[node] = values[node * lanes + lane];
+    }
+}
+
+void NetworkBatch::activate(const float *inputs, float *outputs)
+{
+
+    const float *lane_inputs[lanes];
+    float *lane_outputs[lanes];
+    for (std::size_t lane = 0; lane < lane_count; ++lane)
+    {
+        lane_inputs[lane] = inputs + lane * num_inputs;
+        lane_outputs[lane] = outputs + lane * num_outputs;
+    }
+    activate(lane_inputs, lane_outputs);
+}
+
+void NetworkBatch::activate(const float *const *lane_inputs, float *const *lane_outputs)
+{
+
+    float *v = values.data();
+
+    // Transpose inputs into lane-major order
+    for (std::size_t lane = 0; lane < lane_count; ++lane)
+    {
+        for (std::uint32_t i = 0; i < num_inputs; ++i)
+        {
+            v[i * lanes + lane] = lane_inputs[lane][i];
+        }
+    }
+    std::fill(v + num_inputs * lanes, v + (num_inputs + 1) * lanes, 1.0f); // Bias
+
+    const std::uint32_t *source = edge_source.data();
+    const float *weight = edge_weight.data();
+
+    for (const Network::NodeOp &op : node_ops)
+    {
+        Vec8 sum = zero();
+        const std::uint32_t end = op.first_edge + op.edge_count;
+        for (std::uint32_t e = op.first_edge; e < end; ++e)
+        {
+            sum = multiplyAdd(load(v + source[e] * lanes), load(weight + e * lanes), sum);
+        }
+        store(v + op.target * lanes, activation(sum));
+    }
+
+    const std::uint32_t first_output = num_inputs + 1;
+    for (std::size_t lane = 0; lane < lane_count; ++lane)
+    {
+        for (std::uint32_t o = 0; o < num_outputs; ++o)
+        {
+            lane_outputs[lane][o] = v[(first_output + o) * lanes + lane];
+        }
+    }
+}
+
+BatchedNetworks::BatchedNetworks(const std::vector<Network> &networks, std::size_t min_batch)
+{
+
+    if (networks.empty())
+    {
+        return;
+    }
+    num_inputs = networks[0].numInputs();
+    num_outputs = networks[0].numOutputs();
+
+    // Group by exact topology. The hash narrows candidates, sameTopology() settles collisions. Groups keep
+    // first-seen order so the result doesn't depend on hash map iteration.
+    std::vector<std::vector<std::uint32_t>> groups;
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> groups_by_hash;
+
+    for (std::uint32_t i = 0; i < networks.size(); ++i)
+    {
+        std::vector<std::size_t> &candidates = groups_by_hash[topologyHash(networks[i])];
+
+        auto match = std::find_if(candidates.begin(), candidates.end(), [&](std::size_t group) {
+            return sameTopology(networks[groups[group][0]], networks[i]);
+        });
+
+        if (match == candidates.end())
+        {
+            candidates.push_back(groups.size());
+            groups.push_back({i});
+        }
+        else
+        {
+            groups[*match].push_back(i);
+        }
+    }
+
+    const Network *lane_networks[NetworkBatch::lanes];
+    for (const std::vector<std::uint32_t> &group : groups)
+    {
+        std::size_t next = 0;
+
+        // Full batches first, then whatever is left over, if it still clears min_batch.
+        while (group.size() - next >= std::max<std::size_t>(min_batch, 1))
+        {
+            const std::size_t count = std::min(NetworkBatch::lanes, group.size() - next);
+            for (std::size_t lane = 0; lane < NetworkBatch::lanes; ++lane)
+            {
+                batch_members.push_back(lane < count ? group[next + lane] : group[next]);
+                lane_networks[lane] = &networks[group[next + std::min(lane, count - 1)]];
+            }
+            batches.emplace_back(lane_networks, count);
+            next += count;
+        }
+
+        for (; next < group.size(); ++next)
+        {
+            scalar_networks.push_back(networks[group[next]]);
+            scalar_members.push_back(group[next]);
+        }
+    }
+}
+
+void BatchedNetworks::activate(const float *inputs, float *outputs)
+{
+
+    const float *lane_inputs[NetworkBatch::lanes];
+    float *lane_outputs[NetworkBatch::lanes];
+
+    for (std::size_t b = 0; b < batches.size(); ++b)
+    {
+        NetworkBatch &batch = batches[b];
+        const std::uint32_t *members = &batch_members[b * NetworkBatch::lanes];
+
+        // Point each lane at its network's row; the batch reads and writes them in place.
+        for (std::size_t lane = 0; lane < batch.laneCount(); ++lane)
+        {
+            lane_inputs[lane] = inputs + members[lane] * num_inputs;
+            lane_outputs[lane] = outputs + members[lane] * num_outputs;
+        }
+
+        batch.activate(lane_inputs, lane_outputs);
+    }
+
+    for (std::size_t s = 0; s < scalar_networks.size(); ++s)
+    {
+        const std::uint32_t member = scalar_members[s];
+        scalar_networks[s].activate(inputs + member * num_inputs, outputs + member * num_outputs);
+    }
+}
+
+} // namespace neat
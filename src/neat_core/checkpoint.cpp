@@ -0,0 +1,426 @@
+#include "neat_core/checkpoint.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NEAT_CHECKPOINT_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define NEAT_CHECKPOINT_MMAP 0
+#endif
+
+// Arrays are used in place from the mapping, so the host has to match the file's byte order and float format.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Checkpoints are little-endian and mapped in place; big-endian hosts aren't supported"
+#endif
+static_assert(std::numeric_limits<float>::is_iec559, "Checkpoints store IEEE-754 floats");
+
+namespace neat {
+
+namespace {
+
+enum Section : std::size_t {
+    Genomes,
+    NodeIds,
+    NodeTypes,
+    ConnInnovation,
+    ConnIn,
+    ConnOut,
+    ConnWeight,
+    ConnEnabled,
+    SpeciesTable,
+    Members,
+    RngState,
+    SectionCount
+};
+
+struct SectionEntry {
+    std::uint64_t offset; // From the start of the file
+    std::uint64_t count;  // Elements, not bytes
+};
+
+constexpr char magic[8] = {'N', 'E', 'A', 'T', 'C', 'K', 'P', 'T'};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t file_size;
+
+    std::uint64_t seed;
+    std::uint64_t generation;
+    std::uint32_t num_inputs;
+    std::uint32_t num_outputs;
+    std::uint32_t next_node_id;
+    std::uint32_t next_innovation;
+    std::uint32_t next_species_id;
+    float best_fitness;
+
+    SectionEntry sections[SectionCount];
+};
+
+static_assert(sizeof(FileHeader) % 8 == 0, "Sections after the header must stay 8-byte aligned");
+static_assert(sizeof(GenomeRecord) % 8 == 0 && sizeof(SpeciesRecord) % 8 == 0, "Records must tile unpadded");
+
+struct SectionData {
+    const void *data;
+    std::size_t count;
+    std::size_t element_size;
+};
+
+template <class T> SectionData sectionData(ArrayView<T> view) { return {view.data, view.size, sizeof(T)}; }
+
+std::uint64_t alignUp(std::uint64_t offset) { return (offset + 7) & ~std::uint64_t(7); }
+
+// [first, first + count) fits inside [0, size), without overflowing.
+bool inRange(std::uint64_t first, std::uint64_t count, std::size_t size)
+{
+    return count <= size && first <= size - count;
+}
+
+} // namespace
+
+void PopulationSnapshot::addGenome(const Genome &genome)
+{
+
+    GenomeRecord record;
+    record.first_node = node_ids.size();
+    record.first_connection = conn_innovation.size();
+    record.node_count = static_cast<std::uint32_t>(genome.nodeCount());
+    record.connection_count = static_cast<std::uint32_t>(genome.connectionCount());
+    genomes.push_back(record);
+
+    node_ids.insert(node_ids.end(), genome.nodeIds().begin(), genome.nodeIds().end());
+    node_types.insert(node_types.end(), genome.nodeTypes().begin(), genome.nodeTypes().end());
+
+    conn_innovation.insert(conn_innovation.end(), genome.connectionInnovations().begin(),
+                           genome.connectionInnovations().end());
+    conn_in.insert(conn_in.end(), genome.connectionIn().begin(), genome.connectionIn().end());
+    conn_out.insert(conn_out.end(), genome.connectionOut().begin(), genome.connectionOut().end());
+    conn_weight.insert(conn_weight.end(), genome.connectionWeights().begin(), genome.connectionWeights().end());
+    conn_enabled.insert(conn_enabled.end(), genome.connectionEnabled().begin(), genome.connectionEnabled().end());
+}
+
+CheckpointView PopulationSnapshot::view() const
+{
+
+    CheckpointView checkpoint = header;
+    checkpoint.genomes = viewOf(genomes);
+    checkpoint.node_ids = viewOf(node_ids);
+    checkpoint.node_types = viewOf(node_types);
+    checkpoint.conn_innovation = viewOf(conn_innovation);
+    checkpoint.conn_in = viewOf(conn_in);
+    checkpoint.conn_out = viewOf(conn_out);
+    checkpoint.conn_weight = viewOf(conn_weight);
+    checkpoint.conn_enabled = viewOf(conn_enabled);
+    checkpoint.species = viewOf(species);
+    checkpoint.members = viewOf(members);
+    checkpoint.rng_state = viewOf(rng_state);
+    return checkpoint;
+}
+
+void writeCheckpoint(const CheckpointView &checkpoint, const std::string &path)
+{
+
+    const SectionData sections[SectionCount] = {
+        sectionData(checkpoint.genomes),         sectionData(checkpoint.node_ids),
+        sectionData(checkpoint.node_types),      sectionData(checkpoint.conn_innovation),
+        sectionData(checkpoint.conn_in),         sectionData(checkpoint.conn_out),
+        sectionData(checkpoint.conn_weight),     sectionData(checkpoint.conn_enabled),
+        sectionData(checkpoint.species),         sectionData(checkpoint.members),
+        sectionData(checkpoint.rng_state),
+    };
+
+    FileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = checkpoint_version;
+    header.header_size = sizeof(FileHeader);
+    header.seed = checkpoint.seed;
+    header.generation = checkpoint.generation;
+    header.num_inputs = checkpoint.num_inputs;
+    header.num_outputs = checkpoint.num_outputs;
+    header.next_node_id = checkpoint.next_node_id;
+    header.next_innovation = checkpoint.next_innovation;
+    header.next_species_id = checkpoint.next_species_id;
+    header.best_fitness = checkpoint.best_fitness;
+
+    // Lay the sections out first so the header can go at the front and everything after streams straight out.
+    std::uint64_t end = sizeof(FileHeader);
+    for (std::size_t s = 0; s < SectionCount; ++s)
+    {
+        header.sections[s] = {alignUp(end), sections[s].count};
+        end = header.sections[s].offset + sections[s].count * sections[s].element_size;
+    }
+    header.file_size = end;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("Can't open checkpoint " + path + " for writing");
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    static const char zeros[8] = {};
+    std::uint64_t position = sizeof(FileHeader);
+    for (std::size_t s = 0; s < SectionCount; ++s)
+    {
+        file.write(zeros, static_cast<std::streamsize>(header.sections[s].offset - position));
+
+        const std::uint64_t bytes = sections[s].count * sections[s].element_size;
+        if (bytes > 0)
+        {
+            file.write(static_cast<const char *>(sections[s].data), static_cast<std::streamsize>(bytes));
+        }
+        position = header.sections[s].offset + bytes;
+    }
+
+    if (!file.flush())
+    {
+        throw std::runtime_error("Failed writing checkpoint " + path);
+    }
+}
+
+MappedCheckpoint::MappedCheckpoint(const std::string &path)
+{
+
+#if NEAT_CHECKPOINT_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Can't open checkpoint " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("Can't stat checkpoint " + path);
+    }
+
+    size = static_cast<std::size_t>(info.st_size);
+    void *mapping = size > 0 ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+    ::close(fd); // The mapping keeps the file alive
+
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("Can't map checkpoint " + path);
+    }
+    data = static_cast<const std::byte *>(mapping);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        throw std::runtime_error("Can't open checkpoint " + path);
+    }
+
+    size = static_cast<std::size_t>(file.tellg());
+    fallback.resize(size);
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(fallback.data()), static_cast<std::streamsize>(size));
+    data = fallback.data();
+#endif
+
+    try
+    {
+        validate(path);
+    }
+    catch (...)
+    {
+        release();
+        throw;
+    }
+}
+
+MappedCheckpoint::~MappedCheckpoint() { release(); }
+
+void MappedCheckpoint::release()
+{
+
+#if NEAT_CHECKPOINT_MMAP
+    if (data)
+    {
+        ::munmap(const_cast<std::byte *>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+void MappedCheckpoint::validate(const std::string &path)
+{
+
+    auto fail = [&](const std::string &reason) { throw std::runtime_error("Checkpoint " + path + ": " + reason); };
+
+    if (size < sizeof(FileHeader))
+    {
+        fail("too small to be a checkpoint");
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+    {
+        fail("not a checkpoint file");
+    }
+    if (header.version != checkpoint_version)
+    {
+        fail("format version " + std::to_string(header.version) + ", expected " +
+             std::to_string(checkpoint_version));
+    }
+    if (header.header_size != sizeof(FileHeader) || header.file_size != size)
+    {
+        fail("truncated or corrupt header");
+    }
+
+    auto section = [&](Section s, auto &view) {
+        using T = std::remove_const_t<std::remove_pointer_t<decltype(view.data)>>;
+        const SectionEntry &entry = header.sections[s];
+        if (entry.count > size / sizeof(T) || entry.offset % alignof(T) != 0 ||
+            !inRange(entry.offset, entry.count * sizeof(T), size))
+        {
+            fail("section " + std::to_string(s) + " out of bounds");
+        }
+        view.data = reinterpret_cast<const T *>(data + entry.offset);
+        view.size = static_cast<std::size_t>(entry.count);
+    };
+
+    checkpoint.seed = header.seed;
+    checkpoint.generation = header.generation;
+    checkpoint.num_inputs = header.num_inputs;
+    checkpoint.num_outputs = header.num_outputs;
+    checkpoint.next_node_id = header.next_node_id;
+    checkpoint.next_innovation = header.next_innovation;
+    checkpoint.next_species_id = header.next_species_id;
+    checkpoint.best_fitness = header.best_fitness;
+
+    section(Genomes, checkpoint.genomes);
+    section(NodeIds, checkpoint.node_ids);
+    section(NodeTypes, checkpoint.node_types);
+    section(ConnInnovation, checkpoint.conn_innovation);
+    section(ConnIn, checkpoint.conn_in);
+    section(ConnOut, checkpoint.conn_out);
+    section(ConnWeight, checkpoint.conn_weight);
+    section(ConnEnabled, checkpoint.conn_enabled);
+    section(SpeciesTable, checkpoint.species);
+    section(Members, checkpoint.members);
+    section(RngState, checkpoint.rng_state);
+
+    // One linear pass over the records and genes, so restore() - and the Genome and Network code after it - can
+    // trust every range, node id and index.
+    const std::size_t nodes = checkpoint.node_ids.size;
+    const std::size_t connections = checkpoint.conn_innovation.size;
+    if (checkpoint.node_types.size != nodes || checkpoint.conn_in.size != connections ||
+        checkpoint.conn_out.size != connections || checkpoint.conn_weight.size != connections ||
+        checkpoint.conn_enabled.size != connections || checkpoint.species.size > checkpoint.genomes.size)
+    {
+        fail("section sizes don't agree");
+    }
+
+    const std::uint64_t fixed_nodes = std::uint64_t(checkpoint.num_inputs) + 1 + checkpoint.num_outputs;
+    for (const GenomeRecord &record : checkpoint.genomes)
+    {
+        if (!inRange(record.first_node, record.node_count, nodes) ||
+            !inRange(record.first_connection, record.connection_count, connections))
+        {
+            fail("genome record out of range");
+        }
+        if (record.node_count < fixed_nodes)
+        {
+            fail("genome is missing its input, bias or output nodes");
+        }
+
+        // Nodes: ids strictly increasing (Genome::nodeIndex binary searches them), laid out inputs, bias, outputs,
+        // then hidden, which is what Network::compile indexes by.
+        const std::uint32_t *ids = checkpoint.node_ids.data + record.first_node;
+        const NodeType *types = checkpoint.node_types.data + record.first_node;
+        for (std::uint32_t n = 0; n < record.node_count; ++n)
+        {
+            NodeType expected = NodeType::Hidden;
+            if (n < checkpoint.num_inputs)
+            {
+                expected = NodeType::Input;
+            }
+            else if (n == checkpoint.num_inputs)
+            {
+                expected = NodeType::Bias;
+            }
+            else if (n < fixed_nodes)
+            {
+                expected = NodeType::Output;
+            }
+            if (static_cast<std::uint8_t>(types[n]) != static_cast<std::uint8_t>(expected))
+            {
+                fail("genome node has a bad type");
+            }
+            if (n > 0 && ids[n] <= ids[n - 1])
+            {
+                fail("genome node ids are not sorted");
+            }
+        }
+
+        // Connections: both ends must be nodes of this genome, and nothing may feed an input or the bias.
+        const std::uint32_t *node_end = ids + record.node_count;
+        auto indexOf = [&](std::uint32_t id) {
+            const std::uint32_t *found = std::lower_bound(ids, node_end, id);
+            return found != node_end && *found == id ? static_cast<std::uint64_t>(found - ids) : record.node_count;
+        };
+        for (std::uint64_t c = record.first_connection; c < record.first_connection + record.connection_count; ++c)
+        {
+            const std::uint64_t in = indexOf(checkpoint.conn_in[c]);
+            const std::uint64_t out = indexOf(checkpoint.conn_out[c]);
+            if (in == record.node_count || out == record.node_count)
+            {
+                fail("connection refers to a node its genome doesn't have");
+            }
+            if (out <= checkpoint.num_inputs)
+            {
+                fail("connection feeds an input or the bias");
+            }
+        }
+    }
+
+    // Every genome in exactly one species, as speciate() leaves them: breeding shares out offspring by species, so
+    // a genome in none is never bred from and a population with no species at all can't breed.
+    const std::size_t population = checkpoint.populationSize();
+    std::vector<std::uint8_t> in_species(population, 0);
+    for (const SpeciesRecord &record : checkpoint.species)
+    {
+        if (!inRange(record.first_member, record.member_count, checkpoint.members.size))
+        {
+            fail("species record out of range");
+        }
+        if (record.member_count == 0)
+        {
+            fail("species has no members"); // Offspring shares divide by member counts
+        }
+        for (std::uint64_t m = record.first_member; m < record.first_member + record.member_count; ++m)
+        {
+            const std::uint32_t member = checkpoint.members[m];
+            if (member >= population)
+            {
+                fail("species member out of range");
+            }
+            if (in_species[member])
+            {
+                fail("genome is in more than one species");
+            }
+            in_species[member] = 1;
+        }
+    }
+    if (std::find(in_species.begin(), in_species.end(), 0) != in_species.end())
+    {
+        fail("genome is in no species");
+    }
+}
+
+} // namespace neat
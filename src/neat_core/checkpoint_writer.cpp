@@ -0,0 +1,204 @@
+#include "neat_core/checkpoint_writer.hpp"
+
+#include "neat_core/profiler.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NEAT_CHECKPOINT_FSYNC 1
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#define NEAT_CHECKPOINT_FSYNC 0
+#endif
+
+namespace neat {
+
+namespace {
+
+// fsync()s a file, or a directory so a rename inside it is durable. Returns an error message, empty on success.
+// A no-op where there is no fsync; the rename alone still keeps readers from seeing a partial file.
+std::string syncToDisk(const std::string &path, bool directory)
+{
+
+#if NEAT_CHECKPOINT_FSYNC
+    const int fd = ::open(path.c_str(), directory ? O_RDONLY : O_WRONLY);
+    if (fd < 0)
+    {
+        return "Can't open " + path + " to sync it: " + std::strerror(errno);
+    }
+
+    std::string error;
+    if (::fsync(fd) != 0)
+    {
+        error = "Can't sync " + path + " to disk: " + std::strerror(errno);
+    }
+    ::close(fd);
+    return error;
+#else
+    (void)path;
+    (void)directory;
+    return {};
+#endif
+}
+
+} // namespace
+
+CheckpointWriter::CheckpointWriter(std::size_t max_pending)
+    : max_pending(max_pending > 0 ? max_pending : 1), worker(&CheckpointWriter::run, this)
+{
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_one();
+    worker.join();
+}
+
+void CheckpointWriter::submit(PopulationSnapshot snapshot, std::string path)
+{
+
+    Job superseded; // Freed after the lock is released, not while holding it
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.size() >= max_pending)
+        {
+            superseded = std::move(queue.front());
+            queue.pop_front();
+            ++dropped_count;
+        }
+        queue.push_back(Job{std::move(snapshot), std::move(path)});
+    }
+    work_ready.notify_one();
+}
+
+void CheckpointWriter::flush()
+{
+
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return queue.empty() && !busy; });
+}
+
+std::uint64_t CheckpointWriter::written() const
+{
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return written_count;
+}
+
+std::uint64_t CheckpointWriter::dropped() const
+{
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return dropped_count;
+}
+
+std::string CheckpointWriter::lastError() const
+{
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return last_error;
+}
+
+std::string CheckpointWriter::lastWarning() const
+{
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return last_warning;
+}
+
+void CheckpointWriter::run()
+{
+
+    Profiler::setThreadName("checkpoint writer");
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        work_ready.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty())
+        {
+            return; // Stopping, and everything queued has been written
+        }
+
+        Job job = std::move(queue.front());
+        queue.pop_front();
+        busy = true;
+        lock.unlock();
+
+        // Write beside the target and rename over it, so readers only ever see a complete file. The data is synced
+        // before the rename and the directory after it, so a power cut leaves either the old checkpoint or the
+        // whole new one - never a renamed file whose contents hadn't reached the disk.
+        std::string error;
+        std::string warning;
+        bool renamed = false;
+        const std::string temporary = job.path + ".tmp";
+        try
+        {
+            NEAT_PROFILE_SCOPE("write checkpoint");
+            writeCheckpoint(job.snapshot.view(), temporary);
+            error = syncToDisk(temporary, false);
+
+            if (error.empty())
+            {
+                std::error_code rename_error;
+                std::filesystem::rename(temporary, job.path, rename_error);
+                if (rename_error)
+                {
+                    error = "Can't move checkpoint into place at " + job.path + ": " + rename_error.message();
+                }
+                renamed = !rename_error;
+            }
+        }
+        catch (const std::runtime_error &e)
+        {
+            error = e.what();
+        }
+
+        if (renamed)
+        {
+            // The new checkpoint is in place either way; a failed directory sync only means the rename might not
+            // survive a power cut.
+            const std::filesystem::path directory = std::filesystem::path(job.path).parent_path();
+            warning = syncToDisk(directory.empty() ? "." : directory.string(), true);
+        }
+        else
+        {
+            std::error_code ignored;
+            std::filesystem::remove(temporary, ignored);
+        }
+
+        job = Job{}; // Free the snapshot before taking the lock back
+
+        lock.lock();
+        busy = false;
+        if (renamed)
+        {
+            ++written_count;
+        }
+        if (!error.empty())
+        {
+            last_error = std::move(error);
+        }
+        if (!warning.empty())
+        {
+            last_warning = "Checkpoint written, but it may not survive a power cut: " + std::move(warning);
+        }
+
+        if (queue.empty())
+        {
+            idle.notify_all();
+        }
+    }
+}
+
+} // namespace neat
@@ -0,0 +1,86 @@
+#include "neat_core/fitness.hpp"
+
+#include "neat_core/profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace neat {
+
+FitnessEvaluator::FitnessEvaluator(ThreadPool &pool, EpisodeFunction episode) : pool(pool), episode(std::move(episode))
+{
+}
+
+FitnessEvaluator::FitnessEvaluator(ThreadPool &pool, BatchEpisodeFunction batch_episode, std::size_t batch_size)
+    : pool(pool), batch_episode(std::move(batch_episode)), batch_size(std::max<std::size_t>(1, batch_size))
+{
+}
+
+void FitnessEvaluator::evaluate(const std::vector<Genome> &genomes, std::uint64_t run_seed, std::uint64_t generation,
+                                std::vector<float> &fitness)
+{
+
+    fitness.resize(genomes.size());
+
+    if (batch_episode)
+    {
+        const std::size_t batches = (genomes.size() + batch_size - 1) / batch_size;
+        pool.parallelFor(
+            batches,
+            [&](std::size_t begin, std::size_t end) {
+                std::vector<Network> networks;
+                for (std::size_t b = begin; b < end; ++b)
+                {
+                    NEAT_PROFILE_SCOPE("episode batch");
+                    const std::size_t first = b * batch_size;
+                    const std::size_t last = std::min(genomes.size(), first + batch_size);
+
+                    networks.clear();
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        networks.push_back(Network::compile(genomes[i]));
+                    }
+                    Rng rng = episodeRng(run_seed, generation, first);
+                    batch_episode(networks, rng, &fitness[first]);
+                }
+            },
+            1);
+        return;
+    }
+
+    // Episodes are independent, so each chunk just compiles and plays its own genomes. Results land in
+    // per-genome slots; nothing is shared between threads.
+    pool.parallelFor(genomes.size(), [&](std::size_t begin, std::size_t end) {
+        NEAT_PROFILE_SCOPE("episodes");
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            Network network = Network::compile(genomes[i]);
+            Rng rng = episodeRng(run_seed, generation, i);
+            fitness[i] = episode(network, rng);
+        }
+    });
+}
+
+Rng FitnessEvaluator::episodeRng(std::uint64_t run_seed, std::uint64_t generation, std::uint64_t index)
+{
+    return Rng::stream(run_seed, RngStream::Episode, generation, index);
+}
+
+float xorEpisode(Network &network, Rng &)
+{
+
+    static const float cases[4][3] = {{0, 0, 0}, {0, 1, 1}, {1, 0, 1}, {1, 1, 0}};
+
+    float error = 0.0f;
+    for (const auto &c : cases)
+    {
+        float output = 0.0f;
+        network.activate(c, &output);
+        error += std::fabs(output - c[2]);
+    }
+
+    return (4.0f - error) * (4.0f - error);
+}
+
+} // namespace neat
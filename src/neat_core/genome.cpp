@@ -0,0 +1,407 @@
+#include "neat_core/genome.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace neat {
+
+Genome::Genome(std::pmr::memory_resource *resource)
+    : node_ids(resource), node_types(resource), conn_innovation(resource), conn_in(resource), conn_out(resource),
+      conn_weight(resource), conn_enabled(resource)
+{
+}
+
+Genome::Genome(const Genome &other, std::pmr::memory_resource *resource)
+    : num_inputs(other.num_inputs), num_outputs(other.num_outputs), node_ids(other.node_ids, resource),
+      node_types(other.node_types, resource), conn_innovation(other.conn_innovation, resource),
+      conn_in(other.conn_in, resource), conn_out(other.conn_out, resource), conn_weight(other.conn_weight, resource),
+      conn_enabled(other.conn_enabled, resource)
+{
+}
+
+std::uint32_t Genome::minimalNodeCount(std::uint32_t num_inputs, std::uint32_t num_outputs)
+{
+    return num_inputs + 1 + num_outputs; // + 1 for the bias node
+}
+
+std::uint32_t Genome::minimalInnovationCount(std::uint32_t num_inputs, std::uint32_t num_outputs)
+{
+    return (num_inputs + 1) * num_outputs;
+}
+
+Genome Genome::minimal(std::uint32_t num_inputs, std::uint32_t num_outputs, Rng &rng, const MutationConfig &config,
+                       std::pmr::memory_resource *resource)
+{
+
+    Genome genome(resource);
+    genome.num_inputs = num_inputs;
+    genome.num_outputs = num_outputs;
+
+    const std::uint32_t node_count = minimalNodeCount(num_inputs, num_outputs);
+    genome.node_ids.reserve(node_count);
+    genome.node_types.reserve(node_count);
+
+    for (std::uint32_t id = 0; id < node_count; ++id)
+    {
+        NodeType type = NodeType::Output;
+        if (id < num_inputs)
+        {
+            type = NodeType::Input;
+        }
+        else if (id == num_inputs)
+        {
+            type = NodeType::Bias;
+        }
+
+        genome.node_ids.push_back(id);
+        genome.node_types.push_back(type);
+    }
+
+    // Every input (and the bias) to every output. Innovation = source * num_outputs + output, so they come out
+    // already in innovation order.
+    genome.reserveConnections(minimalInnovationCount(num_inputs, num_outputs));
+    for (std::uint32_t source = 0; source <= num_inputs; ++source)
+    {
+        for (std::uint32_t output = 0; output < num_outputs; ++output)
+        {
+            genome.conn_innovation.push_back(source * num_outputs + output);
+            genome.conn_in.push_back(source);
+            genome.conn_out.push_back(num_inputs + 1 + output);
+            genome.conn_weight.push_back(randomFloat(rng, -config.weight_range, config.weight_range));
+            genome.conn_enabled.push_back(1);
+        }
+    }
+
+    return genome;
+}
+
+Genome Genome::fromGenes(std::uint32_t num_inputs, std::uint32_t num_outputs, const std::uint32_t *node_ids,
+                         const NodeType *node_types, std::size_t node_count, const std::uint32_t *innovations,
+                         const std::uint32_t *in, const std::uint32_t *out, const float *weights,
+                         const std::uint8_t *enabled, std::size_t connection_count, std::pmr::memory_resource *resource)
+{
+
+    Genome genome(resource);
+    genome.num_inputs = num_inputs;
+    genome.num_outputs = num_outputs;
+
+    genome.node_ids.assign(node_ids, node_ids + node_count);
+    genome.node_types.assign(node_types, node_types + node_count);
+
+    genome.conn_innovation.assign(innovations, innovations + connection_count);
+    genome.conn_in.assign(in, in + connection_count);
+    genome.conn_out.assign(out, out + connection_count);
+    genome.conn_weight.assign(weights, weights + connection_count);
+    genome.conn_enabled.assign(enabled, enabled + connection_count);
+
+    return genome;
+}
+
+Genome Genome::crossover(const Genome &fitter, const Genome &other, Rng &rng, const MutationConfig &config,
+                         std::pmr::memory_resource *resource)
+{
+
+    Genome child(resource);
+    child.num_inputs = fitter.num_inputs;
+    child.num_outputs = fitter.num_outputs;
+
+    // Every gene comes from the fitter parent (matching genes share in/out), so its nodes cover the child's.
+    child.node_ids.assign(fitter.node_ids.begin(), fitter.node_ids.end());
+    child.node_types.assign(fitter.node_types.begin(), fitter.node_types.end());
+    child.reserveConnections(fitter.connectionCount());
+
+    const std::size_t other_count = other.connectionCount();
+    std::size_t j = 0;
+
+    for (std::size_t i = 0; i < fitter.connectionCount(); ++i)
+    {
+        const std::uint32_t innovation = fitter.conn_innovation[i];
+        while (j < other_count && other.conn_innovation[j] < innovation)
+        {
+            ++j;
+        }
+
+        float weight = fitter.conn_weight[i];
+        bool enabled = fitter.conn_enabled[i] != 0;
+
+        if (j < other_count && other.conn_innovation[j] == innovation)
+        {
+            // Matching gene - weight from either parent, and it may stay disabled if either parent had it off.
+            if (randomChance(rng, 0.5f))
+            {
+                weight = other.conn_weight[j];
+            }
+            if (!fitter.conn_enabled[i] || !other.conn_enabled[j])
+            {
+                enabled = !randomChance(rng, config.disabled_inherit_rate);
+            }
+        }
+
+        child.conn_innovation.push_back(innovation);
+        child.conn_in.push_back(fitter.conn_in[i]);
+        child.conn_out.push_back(fitter.conn_out[i]);
+        child.conn_weight.push_back(weight);
+        child.conn_enabled.push_back(enabled ? 1 : 0);
+    }
+
+    return child;
+}
+
+float Genome::compatibilityDistance(const Genome &a, const Genome &b, const CompatibilityConfig &config, float limit)
+{
+
+    const std::size_t count_a = a.connectionCount();
+    const std::size_t count_b = b.connectionCount();
+    const float normaliser = static_cast<float>(std::max<std::size_t>(1, std::max(count_a, count_b)));
+
+    // Every term is non-negative, so the mismatch genes counted so far already bound the distance from below.
+    // A size difference alone guarantees that many mismatches, which can rule a pair out before the merge.
+    const float mismatch_cost = std::min(config.excess_coefficient, config.disjoint_coefficient) / normaliser;
+    const std::size_t size_difference = count_a > count_b ? count_a - count_b : count_b - count_a;
+    if (mismatch_cost * size_difference > limit)
+    {
+        return mismatch_cost * size_difference;
+    }
+
+    const float disjoint_cost = config.disjoint_coefficient / normaliser;
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t disjoint = 0;
+    std::size_t matching = 0;
+    float weight_difference = 0.0f;
+
+    // Single merge over both innovation-sorted lists
+    while (i < count_a && j < count_b)
+    {
+        const std::uint32_t innovation_a = a.conn_innovation[i];
+        const std::uint32_t innovation_b = b.conn_innovation[j];
+
+        if (innovation_a == innovation_b)
+        {
+            weight_difference += std::fabs(a.conn_weight[i] - b.conn_weight[j]);
+            ++matching;
+            ++i;
+            ++j;
+        }
+        else
+        {
+            ++disjoint;
+            if (innovation_a < innovation_b)
+            {
+                ++i;
+            }
+            else
+            {
+                ++j;
+            }
+
+            if (disjoint_cost * disjoint > limit)
+            {
+                return disjoint_cost * disjoint;
+            }
+        }
+    }
+
+    const std::size_t excess = (count_a - i) + (count_b - j);
+    const float mean_weight_difference = matching > 0 ? weight_difference / matching : 0.0f;
+
+    return (config.excess_coefficient * excess + config.disjoint_coefficient * disjoint) / normaliser +
+           config.weight_coefficient * mean_weight_difference;
+}
+
+void Genome::mutate(Rng &rng, InnovationRegistry &registry, const MutationConfig &config)
+{
+
+    if (randomChance(rng, config.weight_mutate_rate))
+    {
+        mutateWeights(rng, config);
+    }
+    if (randomChance(rng, config.add_node_rate))
+    {
+        mutateAddNode(rng, registry);
+    }
+    if (randomChance(rng, config.add_connection_rate))
+    {
+        mutateAddConnection(rng, registry, config);
+    }
+}
+
+void Genome::mutateWeights(Rng &rng, const MutationConfig &config)
+{
+
+    for (float &weight : conn_weight)
+    {
+        if (randomChance(rng, config.weight_perturb_rate))
+        {
+            weight += randomGaussian(rng) * config.weight_perturb_power;
+        }
+        else
+        {
+            weight = randomFloat(rng, -config.weight_range, config.weight_range);
+        }
+    }
+}
+
+bool Genome::mutateAddConnection(Rng &rng, InnovationRegistry &registry, const MutationConfig &config)
+{
+
+    // Inputs and bias sort first, and can't be the target of a connection.
+    const std::size_t first_target = num_inputs + 1;
+    if (nodeCount() <= first_target)
+    {
+        return false;
+    }
+
+    for (int attempt = 0; attempt < config.add_connection_attempts; ++attempt)
+    {
+        const std::uint32_t in = node_ids[randomIndex(rng, nodeCount())];
+        const std::uint32_t out = node_ids[first_target + randomIndex(rng, nodeCount() - first_target)];
+
+        if (hasConnection(in, out) || createsCycle(in, out))
+        {
+            continue;
+        }
+
+        const float weight = randomFloat(rng, -config.weight_range, config.weight_range);
+        addConnection(registry.connectionInnovation(in, out), in, out, weight, true);
+        return true;
+    }
+
+    return false;
+}
+
+bool Genome::mutateAddNode(Rng &rng, InnovationRegistry &registry)
+{
+
+    const std::size_t enabled_count = std::count(conn_enabled.begin(), conn_enabled.end(), std::uint8_t(1));
+    if (enabled_count == 0)
+    {
+        return false;
+    }
+
+    // Pick the n-th enabled connection
+    std::size_t pick = randomIndex(rng, enabled_count);
+    std::size_t split = 0;
+    for (; split < connectionCount(); ++split)
+    {
+        if (conn_enabled[split] && pick-- == 0)
+        {
+            break;
+        }
+    }
+
+    const std::uint32_t in = conn_in[split];
+    const std::uint32_t out = conn_out[split];
+    const float weight = conn_weight[split];
+
+    const std::uint32_t node = registry.splitNode(in, out);
+    if (nodeIndex(node) != nodeCount())
+    {
+        return false; // This genome already split that connection
+    }
+
+    // in -> out becomes in -> node -> out. Weight 1 going in and the old weight going out keeps the behaviour
+    // close to what it was.
+    conn_enabled[split] = 0;
+    addNode(node, NodeType::Hidden);
+    addConnection(registry.connectionInnovation(in, node), in, node, 1.0f, true);
+    addConnection(registry.connectionInnovation(node, out), node, out, weight, true);
+
+    return true;
+}
+
+std::size_t Genome::nodeIndex(std::uint32_t id) const
+{
+
+    auto it = std::lower_bound(node_ids.begin(), node_ids.end(), id);
+    if (it == node_ids.end() || *it != id)
+    {
+        return nodeCount();
+    }
+    return static_cast<std::size_t>(it - node_ids.begin());
+}
+
+void Genome::addNode(std::uint32_t id, NodeType type)
+{
+
+    const auto position = std::lower_bound(node_ids.begin(), node_ids.end(), id) - node_ids.begin();
+    node_ids.insert(node_ids.begin() + position, id);
+    node_types.insert(node_types.begin() + position, type);
+}
+
+void Genome::addConnection(std::uint32_t innovation, std::uint32_t in, std::uint32_t out, float weight, bool enabled)
+{
+
+    // Usually the newest innovation and so an append, but a reused number from this generation can land mid-list.
+    const auto position =
+        std::lower_bound(conn_innovation.begin(), conn_innovation.end(), innovation) - conn_innovation.begin();
+
+    conn_innovation.insert(conn_innovation.begin() + position, innovation);
+    conn_in.insert(conn_in.begin() + position, in);
+    conn_out.insert(conn_out.begin() + position, out);
+    conn_weight.insert(conn_weight.begin() + position, weight);
+    conn_enabled.insert(conn_enabled.begin() + position, enabled ? 1 : 0);
+}
+
+void Genome::reserveConnections(std::size_t count)
+{
+
+    conn_innovation.reserve(count);
+    conn_in.reserve(count);
+    conn_out.reserve(count);
+    conn_weight.reserve(count);
+    conn_enabled.reserve(count);
+}
+
+bool Genome::hasConnection(std::uint32_t in, std::uint32_t out) const
+{
+
+    for (std::size_t i = 0; i < connectionCount(); ++i)
+    {
+        if (conn_in[i] == in && conn_out[i] == out)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Genome::createsCycle(std::uint32_t in, std::uint32_t out) const
+{
+
+    // in -> out closes a loop if `in` can already be reached from `out`. Disabled connections count too, since
+    // crossover can turn them back on.
+    std::vector<std::uint8_t> visited(nodeCount(), 0);
+    std::vector<std::uint32_t> stack{out};
+
+    while (!stack.empty())
+    {
+        const std::uint32_t node = stack.back();
+        stack.pop_back();
+
+        if (node == in)
+        {
+            return true;
+        }
+
+        const std::size_t index = nodeIndex(node);
+        if (visited[index])
+        {
+            continue;
+        }
+        visited[index] = 1;
+
+        for (std::size_t i = 0; i < connectionCount(); ++i)
+        {
+            if (conn_in[i] == node)
+            {
+                stack.push_back(conn_out[i]);
+            }
+        }
+    }
+
+    return false;
+}
+
+} // namespace neat
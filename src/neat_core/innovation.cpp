@@ -0,0 +1,153 @@
+#include "neat_core/innovation.hpp"
+
+namespace neat {
+
+namespace {
+
+// splitmix64 finaliser - spreads (in, out) pairs that differ in a few low bits across the whole table.
+std::uint64_t mixHash(std::uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+constexpr std::size_t initial_slots = 64; // Per table; power of two
+
+} // namespace
+
+InnovationRegistry::Table::Table() : slots(initial_slots) {}
+
+std::uint32_t &InnovationRegistry::Table::findOrInsert(std::uint64_t key, std::uint64_t hash, std::uint32_t stamp,
+                                                       bool &inserted)
+{
+
+    if (live_stamp != stamp)
+    {
+        live = 0;
+        live_stamp = stamp;
+    }
+
+    // Keep the load factor under a half so probe runs stay short.
+    if ((live + 1) * 2 > slots.size())
+    {
+        grow(stamp);
+    }
+
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        Slot &slot = slots[i];
+        if (slot.stamp != stamp)
+        {
+            slot = Slot{key, 0, stamp};
+            ++live;
+            inserted = true;
+            return slot.value;
+        }
+        if (slot.key == key)
+        {
+            inserted = false;
+            return slot.value;
+        }
+    }
+}
+
+void InnovationRegistry::Table::clearStamps()
+{
+
+    for (Slot &slot : slots)
+    {
+        slot.stamp = 0;
+    }
+    live = 0;
+}
+
+void InnovationRegistry::Table::grow(std::uint32_t stamp)
+{
+
+    std::vector<Slot> old(slots.size() * 2);
+    old.swap(slots);
+
+    const std::size_t mask = slots.size() - 1;
+    for (const Slot &slot : old)
+    {
+        if (slot.stamp != stamp)
+        {
+            continue;
+        }
+
+        std::size_t i = mixHash(slot.key) & mask;
+        while (slots[i].stamp == stamp)
+        {
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+}
+
+InnovationRegistry::InnovationRegistry(std::uint32_t next_node_id, std::uint32_t next_innovation)
+    : shards(new Shard[std::size_t(1) << shard_bits]), next_node_id(next_node_id), next_innovation(next_innovation)
+{
+}
+
+std::uint32_t InnovationRegistry::connectionInnovation(std::uint32_t in, std::uint32_t out)
+{
+    return lookup(&Shard::connections, next_innovation, in, out);
+}
+
+std::uint32_t InnovationRegistry::splitNode(std::uint32_t in, std::uint32_t out)
+{
+    return lookup(&Shard::splits, next_node_id, in, out);
+}
+
+std::uint32_t InnovationRegistry::lookup(Table Shard::*table, std::atomic<std::uint32_t> &counter, std::uint32_t in,
+                                         std::uint32_t out)
+{
+
+    const std::uint64_t key = (std::uint64_t(in) << 32) | out;
+    const std::uint64_t hash = mixHash(key);
+
+    // Top bits pick the shard, low bits the slot within it, so the two don't correlate.
+    Shard &shard = shards[hash >> (64 - shard_bits)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // The counters are shared by every shard, hence atomic; everything else here is covered by the shard lock.
+    bool inserted = false;
+    std::uint32_t &value = (shard.*table).findOrInsert(key, hash, stamp, inserted);
+    if (inserted)
+    {
+        value = counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    return value;
+}
+
+void InnovationRegistry::newGeneration()
+{
+
+    ++stamp;
+
+    // Stamps wrap after 2^32 generations; wipe them once so stale slots can't pass for live ones.
+    if (stamp == 0)
+    {
+        for (std::size_t s = 0; s < (std::size_t(1) << shard_bits); ++s)
+        {
+            shards[s].connections.clearStamps();
+            shards[s].splits.clearStamps();
+        }
+        stamp = 1;
+    }
+}
+
+void InnovationRegistry::restore(std::uint32_t node_id, std::uint32_t innovation)
+{
+
+    next_node_id.store(node_id, std::memory_order_relaxed);
+    next_innovation.store(innovation, std::memory_order_relaxed);
+    newGeneration();
+}
+
+} // namespace neat
@@ -0,0 +1,158 @@
+#include "neat_core/network.hpp"
+
+#include <algorithm>
+
+namespace neat {
+
+Network Network::compile(const Genome &genome)
+{
+
+    Network network;
+    network.num_inputs = genome.numInputs();
+    network.num_outputs = genome.numOutputs();
+
+    const std::size_t node_count = genome.nodeCount();
+    const std::uint32_t first_output = network.outputOffset();
+    network.values.assign(node_count, 0.0f);
+
+    // Enabled connections as dense node indices (which are also activation buffer indices).
+    std::vector<std::uint32_t> from;
+    std::vector<std::uint32_t> to;
+    std::vector<float> weight;
+    for (std::size_t i = 0; i < genome.connectionCount(); ++i)
+    {
+        if (genome.connectionEnabled()[i])
+        {
+            from.push_back(static_cast<std::uint32_t>(genome.nodeIndex(genome.connectionIn()[i])));
+            to.push_back(static_cast<std::uint32_t>(genome.nodeIndex(genome.connectionOut()[i])));
+            weight.push_back(genome.connectionWeights()[i]);
+        }
+    }
+    const std::size_t edge_count = from.size();
+
+    // Incoming and outgoing edge lists, bucketed per node (counting sort, so no per-node vectors).
+    std::vector<std::uint32_t> incoming_start(node_count + 1, 0);
+    std::vector<std::uint32_t> outgoing_start(node_count + 1, 0);
+    for (std::size_t e = 0; e < edge_count; ++e)
+    {
+        ++incoming_start[to[e] + 1];
+        ++outgoing_start[from[e] + 1];
+    }
+    for (std::size_t n = 0; n < node_count; ++n)
+    {
+        incoming_start[n + 1] += incoming_start[n];
+        outgoing_start[n + 1] += outgoing_start[n];
+    }
+
+    std::vector<std::uint32_t> incoming(edge_count);
+    std::vector<std::uint32_t> outgoing(edge_count);
+    {
+        std::vector<std::uint32_t> incoming_fill(incoming_start.begin(), incoming_start.end() - 1);
+        std::vector<std::uint32_t> outgoing_fill(outgoing_start.begin(), outgoing_start.end() - 1);
+        for (std::uint32_t e = 0; e < edge_count; ++e)
+        {
+            incoming[incoming_fill[to[e]]++] = e;
+            outgoing[outgoing_fill[from[e]]++] = e;
+        }
+    }
+
+    // Only nodes that can reach an output matter - walk backwards from the outputs and drop the rest.
+    std::vector<std::uint8_t> needed(node_count, 0);
+    std::vector<std::uint32_t> stack;
+    for (std::uint32_t o = 0; o < network.num_outputs; ++o)
+    {
+        stack.push_back(first_output + o);
+    }
+    while (!stack.empty())
+    {
+        const std::uint32_t node = stack.back();
+        stack.pop_back();
+        if (needed[node])
+        {
+            continue;
+        }
+        needed[node] = 1;
+        for (std::uint32_t i = incoming_start[node]; i < incoming_start[node + 1]; ++i)
+        {
+            stack.push_back(from[incoming[i]]);
+        }
+    }
+
+    // Kahn's algorithm over the needed nodes. Every edge into a needed node starts at a needed node, so the
+    // in-degrees only need the incoming lists.
+    std::vector<std::uint32_t> in_degree(node_count, 0);
+    std::vector<std::uint32_t> ready;
+    for (std::uint32_t n = 0; n < node_count; ++n)
+    {
+        if (!needed[n])
+        {
+            continue;
+        }
+        in_degree[n] = incoming_start[n + 1] - incoming_start[n];
+        if (in_degree[n] == 0)
+        {
+            ready.push_back(n);
+        }
+    }
+
+    network.edge_source.reserve(edge_count);
+    network.edge_weight.reserve(edge_count);
+
+    // Process in the order nodes become ready. Genomes are acyclic, so every needed node is reached.
+    for (std::size_t r = 0; r < ready.size(); ++r)
+    {
+        const std::uint32_t node = ready[r];
+
+        if (node >= first_output) // Inputs and bias are written directly, not computed
+        {
+            NodeOp op;
+            op.target = node;
+            op.first_edge = static_cast<std::uint32_t>(network.edge_source.size());
+            op.edge_count = incoming_start[node + 1] - incoming_start[node];
+
+            for (std::uint32_t i = incoming_start[node]; i < incoming_start[node + 1]; ++i)
+            {
+                network.edge_source.push_back(from[incoming[i]]);
+                network.edge_weight.push_back(weight[incoming[i]]);
+            }
+            network.node_ops.push_back(op);
+        }
+
+        for (std::uint32_t i = outgoing_start[node]; i < outgoing_start[node + 1]; ++i)
+        {
+            const std::uint32_t next = to[outgoing[i]];
+            if (needed[next] && --in_degree[next] == 0)
+            {
+                ready.push_back(next);
+            }
+        }
+    }
+
+    return network;
+}
+
+void Network::activate(const float *inputs, float *outputs)
+{
+
+    float *v = values.data();
+    std::copy(inputs, inputs + num_inputs, v);
+    v[num_inputs] = 1.0f; // Bias
+
+    const std::uint32_t *source = edge_source.data();
+    const float *weight = edge_weight.data();
+
+    for (const NodeOp &op : node_ops)
+    {
+        float sum = 0.0f;
+        const std::uint32_t end = op.first_edge + op.edge_count;
+        for (std::uint32_t e = op.first_edge; e < end; ++e)
+        {
+            sum += v[source[e]] * weight[e];
+        }
+        v[op.target] = neuronActivation(sum);
+    }
+
+    std::copy(v + outputOffset(), v + outputOffset() + num_outputs, outputs);
+}
+
+} // namespace neat
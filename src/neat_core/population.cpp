@@ -0,0 +1,438 @@
+#include "neat_core/population.hpp"
+
+#include "neat_core/profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace neat {
+
+Population::Population(const PopulationConfig &config, ThreadPool *pool)
+    : config(config), pool(pool), rng(Rng::stream(config.seed, RngStream::Breeding)),
+      innovations(Genome::minimalNodeCount(config.num_inputs, config.num_outputs),
+                  Genome::minimalInnovationCount(config.num_inputs, config.num_outputs)),
+      fitness(config.size, 0.0f)
+{
+
+    genomes.reserve(config.size);
+    for (std::size_t i = 0; i < config.size; ++i)
+    {
+        genomes.push_back(
+            Genome::minimal(config.num_inputs, config.num_outputs, rng, config.mutation, &arenas[parent_arena]));
+    }
+
+    speciate(std::vector<std::uint32_t>(genomes.size(), no_species));
+}
+
+void Population::epoch(FitnessEvaluator &evaluator)
+{
+
+    NEAT_PROFILE_SCOPE("epoch");
+
+    evaluate(evaluator);
+
+    best_fitness = fitness.empty() ? 0.0f : *std::max_element(fitness.begin(), fitness.end());
+    updateSpeciesStats();
+
+    reproduce();
+    ++generation_count;
+}
+
+void Population::respeciate()
+{
+
+    std::vector<std::uint32_t> hints(genomes.size(), no_species);
+    for (std::uint32_t s = 0; s < species.size(); ++s)
+    {
+        for (std::uint32_t member : species[s].members)
+        {
+            hints[member] = s;
+        }
+    }
+
+    speciate(hints);
+}
+
+PopulationSnapshot Population::snapshot() const
+{
+
+    PopulationSnapshot snapshot;
+    CheckpointView &header = snapshot.header;
+    header.seed = config.seed;
+    header.generation = generation_count;
+    header.num_inputs = config.num_inputs;
+    header.num_outputs = config.num_outputs;
+    header.next_node_id = innovations.nextNodeId();
+    header.next_innovation = innovations.nextInnovation();
+    header.next_species_id = next_species_id;
+    header.best_fitness = best_fitness;
+
+    snapshot.genomes.reserve(genomes.size() + species.size());
+    for (const Genome &genome : genomes)
+    {
+        snapshot.addGenome(genome);
+    }
+
+    for (const Species &s : species)
+    {
+        snapshot.addGenome(s.representative);
+
+        SpeciesRecord record;
+        record.first_member = snapshot.members.size();
+        record.last_improved = s.last_improved;
+        record.id = s.id;
+        record.member_count = static_cast<std::uint32_t>(s.members.size());
+        record.best_fitness = s.best_fitness;
+        snapshot.species.push_back(record);
+        snapshot.members.insert(snapshot.members.end(), s.members.begin(), s.members.end());
+    }
+
+    snapshot.rng_state.assign(rng.state().begin(), rng.state().end());
+
+    return snapshot;
+}
+
+void Population::restore(const CheckpointView &checkpoint)
+{
+
+    if (checkpoint.num_inputs != config.num_inputs || checkpoint.num_outputs != config.num_outputs)
+    {
+        throw std::runtime_error("Checkpoint has " + std::to_string(checkpoint.num_inputs) + " inputs and " +
+                                 std::to_string(checkpoint.num_outputs) + " outputs, population expects " +
+                                 std::to_string(config.num_inputs) + " and " + std::to_string(config.num_outputs));
+    }
+
+    Rng::State rng_state{};
+    if (checkpoint.rng_state.size != rng_state.size())
+    {
+        throw std::runtime_error("Checkpoint has an unreadable RNG state");
+    }
+    std::copy(checkpoint.rng_state.begin(), checkpoint.rng_state.end(), rng_state.begin());
+
+    Rng restored_rng;
+    if (!restored_rng.setState(rng_state))
+    {
+        throw std::runtime_error("Checkpoint has an unreadable RNG state");
+    }
+
+    auto genomeAt = [&](std::size_t index, std::pmr::memory_resource *resource) {
+        const GenomeRecord &r = checkpoint.genomes[index];
+        const std::size_t c = r.first_connection;
+        return Genome::fromGenes(checkpoint.num_inputs, checkpoint.num_outputs, checkpoint.node_ids.data + r.first_node,
+                                 checkpoint.node_types.data + r.first_node, r.node_count,
+                                 checkpoint.conn_innovation.data + c, checkpoint.conn_in.data + c,
+                                 checkpoint.conn_out.data + c, checkpoint.conn_weight.data + c,
+                                 checkpoint.conn_enabled.data + c, r.connection_count, resource);
+    };
+
+    rng = restored_rng;
+    config.seed = checkpoint.seed;
+    config.size = checkpoint.populationSize();
+    innovations.restore(checkpoint.next_node_id, checkpoint.next_innovation);
+    generation_count = checkpoint.generation;
+    best_fitness = checkpoint.best_fitness;
+    next_species_id = checkpoint.next_species_id;
+
+    genomes.clear();
+    offspring.clear();
+    arenas[0].reset();
+    arenas[1].reset();
+    parent_arena = 0;
+
+    genomes.reserve(config.size);
+    for (std::size_t i = 0; i < config.size; ++i)
+    {
+        genomes.push_back(genomeAt(i, &arenas[parent_arena]));
+    }
+    fitness.assign(genomes.size(), 0.0f);
+
+    species.clear();
+    for (std::size_t s = 0; s < checkpoint.species.size; ++s)
+    {
+        const SpeciesRecord &record = checkpoint.species[s];
+        const std::uint32_t *first_member = checkpoint.members.data + record.first_member;
+
+        Species restored;
+        restored.id = record.id;
+        restored.representative = genomeAt(config.size + s, std::pmr::get_default_resource());
+        restored.members.assign(first_member, first_member + record.member_count);
+        restored.best_fitness = record.best_fitness;
+        restored.last_improved = record.last_improved;
+        species.push_back(std::move(restored));
+    }
+}
+
+void Population::evaluate(FitnessEvaluator &evaluator)
+{
+    NEAT_PROFILE_SCOPE("evaluate");
+    evaluator.evaluate(genomes, config.seed, generation_count, fitness);
+}
+
+void Population::updateSpeciesStats()
+{
+
+    for (Species &s : species)
+    {
+        float best = -std::numeric_limits<float>::infinity();
+        for (std::uint32_t member : s.members)
+        {
+            best = std::max(best, fitness[member]);
+        }
+
+        if (best > s.best_fitness)
+        {
+            s.best_fitness = best;
+            s.last_improved = generation_count;
+        }
+    }
+}
+
+std::vector<std::size_t> Population::allotOffspring() const
+{
+
+    if (species.empty())
+    {
+        return {}; // Nothing to share out between; reproduce() speciates first so this doesn't happen
+    }
+
+    const float min_fitness = *std::min_element(fitness.begin(), fitness.end());
+    const std::size_t champion =
+        static_cast<std::size_t>(std::max_element(fitness.begin(), fitness.end()) - fitness.begin());
+
+    // Share = mean fitness (shifted to be non-negative) across the species, i.e. explicit fitness sharing.
+    // Stagnant species get nothing, except the one holding the current champion.
+    std::vector<double> shares(species.size(), 0.0);
+    double total = 0.0;
+    std::size_t champion_species = species.size();
+    for (std::size_t s = 0; s < species.size(); ++s)
+    {
+        const Species &sp = species[s];
+        const bool has_champion = std::find(sp.members.begin(), sp.members.end(), champion) != sp.members.end();
+        if (has_champion)
+        {
+            champion_species = s;
+        }
+        else if (generation_count - sp.last_improved >= config.stagnation_limit)
+        {
+            continue;
+        }
+
+        double sum = 0.0;
+        for (std::uint32_t member : sp.members)
+        {
+            sum += fitness[member] - min_fitness;
+        }
+        shares[s] = sum / sp.members.size() + 1e-6; // Epsilon so all-equal fitness still splits evenly
+        total += shares[s];
+    }
+
+    // Largest-remainder rounding so the counts add up to exactly the population size.
+    std::vector<std::size_t> counts(species.size(), 0);
+    std::vector<std::pair<double, std::size_t>> remainders;
+    std::size_t allotted = 0;
+    for (std::size_t s = 0; s < species.size(); ++s)
+    {
+        const double quota = shares[s] / total * genomes.size();
+        counts[s] = static_cast<std::size_t>(quota);
+        allotted += counts[s];
+        remainders.emplace_back(quota - counts[s], s);
+    }
+
+    std::stable_sort(remainders.begin(), remainders.end(),
+                     [](const auto &a, const auto &b) { return a.first > b.first; });
+    for (std::size_t i = 0; allotted < genomes.size(); ++i, ++allotted)
+    {
+        ++counts[remainders[i % remainders.size()].second];
+    }
+
+    // reproduce() carries the champion over through its species' first slot, so rounding mustn't leave that
+    // species with none. The slot comes from the largest allotment.
+    if (champion_species < species.size() && counts[champion_species] == 0)
+    {
+        --*std::max_element(counts.begin(), counts.end());
+        counts[champion_species] = 1;
+    }
+
+    return counts;
+}
+
+void Population::reproduce()
+{
+
+    NEAT_PROFILE_SCOPE("reproduce");
+
+    if (genomes.empty())
+    {
+        return;
+    }
+
+    // speciate() and restore() (through MappedCheckpoint's checks) leave every genome in a species; should that
+    // ever not hold, sort them now rather than breed nothing.
+    if (species.empty())
+    {
+        speciate(std::vector<std::uint32_t>(genomes.size(), no_species));
+    }
+
+    const std::vector<std::size_t> counts = allotOffspring();
+    const std::size_t champion =
+        static_cast<std::size_t>(std::max_element(fitness.begin(), fitness.end()) - fitness.begin());
+
+    innovations.newGeneration();
+
+    Arena *child_arena = &arenas[1 - parent_arena];
+    std::vector<Genome> &children = offspring;
+    children.clear();
+    children.reserve(genomes.size());
+
+    std::vector<std::uint32_t> hints; // Species each child tries first when it's speciated
+    hints.reserve(genomes.size());
+
+    std::vector<std::uint32_t> ranked;
+    for (std::uint32_t s = 0; s < species.size(); ++s)
+    {
+        std::size_t remaining = counts[s];
+        if (remaining == 0)
+        {
+            continue;
+        }
+
+        ranked = species[s].members;
+        std::stable_sort(ranked.begin(), ranked.end(),
+                         [this](std::uint32_t a, std::uint32_t b) { return fitness[a] > fitness[b]; });
+
+        // Champions of decent-sized species (and always the overall champion) go through unchanged.
+        if (ranked.size() >= config.species_elite_size || ranked[0] == champion)
+        {
+            children.emplace_back(genomes[ranked[0]], child_arena);
+            hints.push_back(s);
+            --remaining;
+        }
+
+        const std::size_t parents = std::max<std::size_t>(
+            1, static_cast<std::size_t>(std::ceil(config.survival_threshold * ranked.size())));
+
+        for (; remaining > 0; --remaining)
+        {
+            const std::uint32_t mother = ranked[randomIndex(rng, parents)];
+
+            if (parents > 1 && randomChance(rng, config.crossover_rate))
+            {
+                const std::uint32_t father = ranked[randomIndex(rng, parents)];
+                const bool mother_fitter = fitness[mother] >= fitness[father];
+                const Genome &fitter = genomes[mother_fitter ? mother : father];
+                const Genome &other = genomes[mother_fitter ? father : mother];
+                children.push_back(Genome::crossover(fitter, other, rng, config.mutation, child_arena));
+            }
+            else
+            {
+                children.emplace_back(genomes[mother], child_arena);
+            }
+
+            children.back().mutate(rng, innovations, config.mutation);
+            hints.push_back(s);
+        }
+    }
+
+    // Retire the parents: destroy them, then drop their whole arena in one go.
+    genomes.swap(children);
+    children.clear();
+    arenas[parent_arena].reset();
+    parent_arena = 1 - parent_arena;
+
+    fitness.assign(genomes.size(), 0.0f);
+    speciate(hints);
+}
+
+void Population::speciate(const std::vector<std::uint32_t> &hints)
+{
+
+    NEAT_PROFILE_SCOPE("speciate");
+
+    const std::size_t existing = species.size();
+    for (Species &s : species)
+    {
+        s.members.clear();
+    }
+
+    // Match every genome against last generation's representatives. They're read-only during this pass, so it
+    // runs in parallel; each genome tries its parent's species first, which is nearly always the right one.
+    std::vector<std::uint32_t> assignment(genomes.size());
+    auto assign = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            assignment[i] = findSpecies(genomes[i], hints[i], 0, existing);
+        }
+    };
+
+    if (pool)
+    {
+        pool->parallelFor(genomes.size(), assign);
+    }
+    else
+    {
+        assign(0, genomes.size());
+    }
+
+    // Genomes that fit nowhere found (or join) new species, in order, so this part stays serial.
+    for (std::uint32_t i = 0; i < genomes.size(); ++i)
+    {
+        std::uint32_t s = assignment[i];
+        if (s == no_species)
+        {
+            s = findSpecies(genomes[i], no_species, existing, species.size());
+        }
+
+        if (s == no_species)
+        {
+            Species created;
+            created.id = next_species_id++;
+            created.representative = Genome(genomes[i], std::pmr::get_default_resource());
+            created.last_improved = generation_count;
+            species.push_back(std::move(created));
+            s = static_cast<std::uint32_t>(species.size() - 1);
+        }
+
+        species[s].members.push_back(i);
+    }
+
+    species.erase(std::remove_if(species.begin(), species.end(), [](const Species &s) { return s.members.empty(); }),
+                  species.end());
+
+    // Next generation gets compared against a random member of this one. Copied out, since the arena holding
+    // this generation is reset once its children are bred.
+    for (Species &s : species)
+    {
+        const std::uint32_t pick = s.members[randomIndex(rng, s.members.size())];
+        s.representative = Genome(genomes[pick], std::pmr::get_default_resource());
+    }
+}
+
+std::uint32_t Population::findSpecies(const Genome &genome, std::uint32_t hint, std::size_t first,
+                                      std::size_t last) const
+{
+
+    const float threshold = config.compatibility.threshold;
+    auto matches = [&](std::size_t s) {
+        return Genome::compatibilityDistance(genome, species[s].representative, config.compatibility, threshold) <
+               threshold;
+    };
+
+    if (hint != no_species && hint >= first && hint < last && matches(hint))
+    {
+        return hint;
+    }
+
+    for (std::size_t s = first; s < last; ++s)
+    {
+        if (s != hint && matches(s))
+        {
+            return static_cast<std::uint32_t>(s);
+        }
+    }
+
+    return no_species;
+}
+
+} // namespace neat
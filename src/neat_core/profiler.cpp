@@ -0,0 +1,162 @@
+#include "neat_core/profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace neat {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Fields are relaxed atomics so a reader copying a slot the owner is overwriting is a benign lost event rather
+// than a data race; on x86 and ARM they compile to plain loads and stores.
+struct Slot {
+    std::atomic<const char *> name{nullptr};
+    std::atomic<std::uint64_t> start_ns{0};
+    std::atomic<std::uint64_t> end_ns{0};
+    std::atomic<std::uint32_t> depth{0};
+};
+
+struct ThreadRing {
+    std::uint32_t id = 0;
+    std::string name; // Guarded by the registry mutex
+    std::unique_ptr<Slot[]> slots{new Slot[Profiler::ring_capacity]};
+    std::atomic<std::uint64_t> written{0}; // Events ever recorded; slot = written % capacity
+};
+
+// Rings live as long as the process, so a reader never sees one vanish when its thread exits.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+const Clock::time_point start_time = Clock::now();
+std::atomic<bool> enabled_flag{true};
+
+thread_local ThreadRing *local_ring = nullptr;
+thread_local std::uint32_t local_depth = 0;
+
+ThreadRing &localRing()
+{
+
+    if (!local_ring)
+    {
+        auto ring = std::make_shared<ThreadRing>();
+
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        ring->id = static_cast<std::uint32_t>(reg.rings.size());
+        ring->name = "thread " + std::to_string(ring->id);
+        reg.rings.push_back(ring);
+        local_ring = ring.get();
+    }
+    return *local_ring;
+}
+
+} // namespace
+
+void Profiler::setEnabled(bool enabled) { enabled_flag.store(enabled, std::memory_order_relaxed); }
+
+bool Profiler::enabled() { return enabled_flag.load(std::memory_order_relaxed); }
+
+void Profiler::setThreadName(const std::string &name)
+{
+
+    ThreadRing &ring = localRing();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    ring.name = name;
+}
+
+std::uint64_t Profiler::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_time).count();
+}
+
+void Profiler::record(const char *name, std::uint64_t start_ns, std::uint64_t end_ns, std::uint32_t depth)
+{
+
+    ThreadRing &ring = localRing();
+    const std::uint64_t index = ring.written.load(std::memory_order_relaxed);
+
+    Slot &slot = ring.slots[index % ring_capacity];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start_ns.store(start_ns, std::memory_order_relaxed);
+    slot.end_ns.store(end_ns, std::memory_order_relaxed);
+    slot.depth.store(depth, std::memory_order_relaxed);
+
+    ring.written.store(index + 1, std::memory_order_release);
+}
+
+std::uint32_t Profiler::enterScope() { return local_depth++; }
+
+void Profiler::leaveScope() { --local_depth; }
+
+std::vector<ProfileReader::ThreadEvents> ProfileReader::poll()
+{
+
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    std::vector<ThreadEvents> result;
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        rings = reg.rings;
+
+        result.resize(rings.size());
+        for (std::size_t i = 0; i < rings.size(); ++i)
+        {
+            result[i].thread_id = rings[i]->id;
+            result[i].thread_name = rings[i]->name;
+        }
+    }
+    cursors.resize(rings.size(), 0);
+
+    for (std::size_t i = 0; i < rings.size(); ++i)
+    {
+        const ThreadRing &ring = *rings[i];
+        ThreadEvents &out = result[i];
+
+        const std::uint64_t written = ring.written.load(std::memory_order_acquire);
+        std::uint64_t from = cursors[i];
+        if (written - from > Profiler::ring_capacity)
+        {
+            out.dropped += written - from - Profiler::ring_capacity;
+            from = written - Profiler::ring_capacity;
+        }
+
+        out.events.reserve(written - from);
+        for (std::uint64_t index = from; index < written; ++index)
+        {
+            const Slot &slot = ring.slots[index % Profiler::ring_capacity];
+            out.events.push_back({slot.name.load(std::memory_order_relaxed),
+                                  slot.start_ns.load(std::memory_order_relaxed),
+                                  slot.end_ns.load(std::memory_order_relaxed),
+                                  slot.depth.load(std::memory_order_relaxed)});
+        }
+
+        // The owner may have lapped us while we copied. Anything it has overwritten since - or is overwriting right
+        // now, hence the + 1 - is unreliable.
+        const std::uint64_t reach = ring.written.load(std::memory_order_acquire) + 1;
+        if (reach - from > Profiler::ring_capacity)
+        {
+            const std::uint64_t lost = std::min<std::uint64_t>(reach - from - Profiler::ring_capacity, written - from);
+            out.events.erase(out.events.begin(), out.events.begin() + static_cast<std::ptrdiff_t>(lost));
+            out.dropped += lost;
+        }
+
+        cursors[i] = written;
+    }
+
+    return result;
+}
+
+} // namespace neat
@@ -0,0 +1,54 @@
+#include "neat_core/rng.hpp"
+
+namespace neat {
+
+namespace {
+
+// splitmix64 step - the seeding procedure xoshiro's authors recommend, and a good 64-bit hash on its own.
+std::uint64_t splitMix(std::uint64_t &x)
+{
+
+    std::uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+Rng::Rng(std::uint64_t seed)
+{
+
+    // splitmix64 never yields four zeros in a row, so every seed gives a valid state.
+    for (std::uint64_t &word : s)
+    {
+        word = splitMix(seed);
+    }
+}
+
+Rng Rng::stream(std::uint64_t seed, RngStream purpose, std::uint64_t key0, std::uint64_t key1)
+{
+
+    // Fold each key into the running hash, so (a, b) and (b, a) don't collide.
+    std::uint64_t h = seed;
+    std::uint64_t mixed = splitMix(h);
+    for (std::uint64_t key : {static_cast<std::uint64_t>(purpose), key0, key1})
+    {
+        h = mixed ^ key;
+        mixed = splitMix(h);
+    }
+    return Rng(mixed);
+}
+
+bool Rng::setState(const State &state)
+{
+
+    if (state[0] == 0 && state[1] == 0 && state[2] == 0 && state[3] == 0)
+    {
+        return false;
+    }
+    s = state;
+    return true;
+}
+
+} // namespace neat
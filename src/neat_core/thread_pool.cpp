@@ -0,0 +1,172 @@
+#include "neat_core/thread_pool.hpp"
+
+#include "neat_core/profiler.hpp"
+
+#include <algorithm>
+
+namespace neat {
+
+namespace {
+
+// Which pool/queue the current thread belongs to, so nested parallelFor() calls use their own deque.
+thread_local const void *current_pool = nullptr;
+thread_local std::size_t current_queue = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t thread_count)
+{
+
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (std::size_t i = 0; i < thread_count; ++i)
+    {
+        queues.push_back(std::make_unique<TaskQueue>());
+    }
+
+    for (std::size_t i = 0; i + 1 < thread_count; ++i)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    sleep_cv.notify_all();
+
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)> &body,
+                             std::size_t grain)
+{
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (grain == 0)
+    {
+        grain = std::max<std::size_t>(1, count / (threadCount() * 8));
+    }
+
+    if (threadCount() == 1 || count <= grain)
+    {
+        body(0, count);
+        return;
+    }
+
+    const std::size_t chunks = (count + grain - 1) / grain;
+    std::atomic<std::size_t> remaining{chunks};
+
+    // Deal the chunks out round-robin so everyone starts with local work; stealing evens out the rest.
+    pending.fetch_add(chunks, std::memory_order_release);
+    for (std::size_t c = 0; c < chunks; ++c)
+    {
+        const std::size_t begin = c * grain;
+        TaskQueue &queue = *queues[c % queues.size()];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task{&body, begin, std::min(count, begin + grain), &remaining});
+    }
+
+    {
+        // Lock so a worker between its predicate check and its wait can't miss the wakeup.
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    sleep_cv.notify_all();
+
+    // Help out until every chunk of this call has finished (not just been picked up).
+    const std::size_t index = current_pool == this ? current_queue : queues.size() - 1;
+    while (remaining.load(std::memory_order_acquire) != 0)
+    {
+        Task task;
+        if (findTask(index, task))
+        {
+            runTask(task);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::workerLoop(std::size_t index)
+{
+
+    current_pool = this;
+    current_queue = index;
+    Profiler::setThreadName("worker " + std::to_string(index));
+
+    while (true)
+    {
+        Task task;
+        if (findTask(index, task))
+        {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        sleep_cv.wait(lock, [this] { return stopping || pending.load(std::memory_order_acquire) > 0; });
+        if (stopping)
+        {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::findTask(std::size_t index, Task &task)
+{
+
+    const std::size_t queue_count = queues.size();
+    for (std::size_t offset = 0; offset < queue_count; ++offset)
+    {
+        const std::size_t victim = (index + offset) % queue_count;
+        TaskQueue &queue = *queues[victim];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            continue;
+        }
+
+        // Newest from our own queue (still warm in cache), oldest from anyone else's.
+        if (victim == index)
+        {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::runTask(const Task &task)
+{
+
+    (*task.body)(task.begin, task.end);
+    task.remaining->fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace neat
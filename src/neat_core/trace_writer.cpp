@@ -0,0 +1,169 @@
+#include "neat_core/trace_writer.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <stdexcept>
+
+namespace neat {
+
+namespace {
+
+void appendEscaped(std::string &out, const char *text)
+{
+
+    for (const char *c = text; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            out += '\\';
+            out += *c;
+        }
+        else if (static_cast<unsigned char>(*c) < 0x20)
+        {
+            out += ' ';
+        }
+        else
+        {
+            out += *c;
+        }
+    }
+}
+
+// Trace timestamps are microseconds; keep the nanoseconds as decimals.
+void appendMicros(std::string &out, std::uint64_t ns)
+{
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "%" PRIu64 ".%03u", ns / 1000, static_cast<unsigned>(ns % 1000));
+    out += text;
+}
+
+} // namespace
+
+TraceWriter::TraceWriter(const std::string &path, std::chrono::milliseconds interval)
+    : path(path), interval(interval), file(path, std::ios::binary | std::ios::trunc)
+{
+
+    if (!file)
+    {
+        throw std::runtime_error("Can't open trace " + path + " for writing");
+    }
+    file << "[\n";
+    worker = std::thread(&TraceWriter::run, this);
+}
+
+TraceWriter::~TraceWriter() { finish(); }
+
+void TraceWriter::finish()
+{
+
+    if (!worker.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+std::string TraceWriter::lastError() const
+{
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return last_error;
+}
+
+void TraceWriter::run()
+{
+
+    Profiler::setThreadName("trace writer");
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping)
+    {
+        wake.wait_for(lock, interval, [this] { return stopping; });
+
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+    lock.unlock();
+
+    file << "\n]\n";
+    file.flush();
+    if (!file)
+    {
+        lock.lock();
+        last_error = "Failed writing trace " + path;
+    }
+}
+
+void TraceWriter::drain()
+{
+
+    NEAT_PROFILE_SCOPE("trace drain");
+
+    buffer.clear();
+    auto separate = [this] {
+        buffer += first_event ? "" : ",\n";
+        first_event = false;
+    };
+
+    std::uint64_t written = 0;
+    std::uint64_t dropped = 0;
+    for (const ProfileReader::ThreadEvents &thread : reader.poll())
+    {
+        const std::string tid = std::to_string(thread.thread_id);
+        if (thread.thread_id >= thread_names.size())
+        {
+            thread_names.resize(thread.thread_id + 1);
+        }
+
+        // Metadata names the thread's track; written again if the thread renames itself.
+        if (thread_names[thread.thread_id] != thread.thread_name)
+        {
+            thread_names[thread.thread_id] = thread.thread_name;
+            separate();
+            buffer += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":\"";
+            appendEscaped(buffer, thread.thread_name.c_str());
+            buffer += "\"}}";
+        }
+
+        for (const ProfileEvent &event : thread.events)
+        {
+            separate();
+            buffer += "{\"name\":\"";
+            appendEscaped(buffer, event.name);
+            buffer += "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"ts\":";
+            appendMicros(buffer, event.start_ns);
+            buffer += ",\"dur\":";
+            appendMicros(buffer, event.end_ns - event.start_ns);
+            buffer += '}';
+        }
+
+        written += thread.events.size();
+        dropped += thread.dropped;
+    }
+
+    if (buffer.empty())
+    {
+        return;
+    }
+
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.flush(); // So the file is usable even if the process dies before the destructor
+    if (!file)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        last_error = "Failed writing trace " + path;
+    }
+
+    events_written.fetch_add(written, std::memory_order_relaxed);
+    dropped_count.fetch_add(dropped, std::memory_order_relaxed);
+}
+
+} // namespace neat
@@ -0,0 +1,538 @@
+#include "sim/encounter.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace sim {
+
+namespace {
+
+Role slotRole(std::uint32_t slot) { return slot == 0 ? Role::Tank : slot == 1 ? Role::Healer : Role::Dps; }
+
+} // namespace
+
+EncounterWorld::EncounterWorld(const EncounterConfig &config, std::size_t instances)
+    : config(config), instance_count(instances), party_size(config.partySize()),
+      grid(-config.arena_half_size, -config.arena_half_size, config.arena_half_size, config.arena_half_size,
+           config.ally_radius, static_cast<std::uint32_t>(std::max<std::size_t>(1, instances)))
+{
+
+    const std::size_t agents = instances * party_size;
+
+    role.resize(agents);
+    agent_instance.resize(agents);
+    for (std::size_t a = 0; a < agents; ++a)
+    {
+        role[a] = slotRole(static_cast<std::uint32_t>(a % party_size));
+        agent_instance[a] = static_cast<std::uint32_t>(a / party_size);
+    }
+
+    for (std::vector<float> *component : {&pos_x, &pos_y, &vel_x, &vel_y, &hp, &threat, &cooldown, &active, &move_x,
+                                          &move_y})
+    {
+        component->assign(agents, 0.0f);
+    }
+    act.assign(agents, 0);
+
+    for (std::vector<float> *component :
+         {&boss_x, &boss_y, &boss_hp, &boss_attack_timer, &boss_aoe_cycle, &aoe_x, &aoe_y, &aoe_timer})
+    {
+        component->assign(instances, 0.0f);
+    }
+    boss_target.assign(instances, 0);
+    finish_tick.assign(instances, 0);
+    done.assign(instances, 1); // Nothing runs until reset()
+}
+
+void EncounterWorld::reset(neat::Rng &rng)
+{
+
+    const float h = config.arena_half_size;
+    ticks = 0;
+    running_count = instance_count;
+
+    for (std::size_t i = 0; i < instance_count; ++i)
+    {
+        boss_x[i] = 0.0f;
+        boss_y[i] = 0.0f;
+        boss_hp[i] = config.boss_hp;
+        boss_attack_timer[i] = config.boss_attack_period;
+        boss_aoe_cycle[i] = config.boss_aoe_period;
+        aoe_x[i] = 0.0f;
+        aoe_y[i] = 0.0f;
+        aoe_timer[i] = 0.0f;
+        boss_target[i] = 0;
+        finish_tick[i] = 0;
+        done[i] = 0;
+    }
+
+    for (std::size_t a = 0; a < role.size(); ++a)
+    {
+        pos_x[a] = neat::randomFloat(rng, -0.5f * h, 0.5f * h);
+        pos_y[a] = neat::randomFloat(rng, -h, -0.6f * h);
+        vel_x[a] = 0.0f;
+        vel_y[a] = 0.0f;
+        hp[a] = config.stats(role[a]).max_hp;
+        threat[a] = 0.0f;
+        cooldown[a] = 0.0f;
+        active[a] = 1.0f;
+        move_x[a] = 0.0f;
+        move_y[a] = 0.0f;
+        act[a] = 0;
+    }
+
+    grid.build(pos_x.data(), pos_y.data(), role.size(), agent_instance.data());
+}
+
+void EncounterWorld::gatherSensors(float *sensors) const
+{
+
+    const float inv = 1.0f / config.arena_half_size;
+
+    for (std::size_t i = 0; i < instance_count; ++i)
+    {
+        if (done[i])
+        {
+            continue; // Nobody reads a finished instance's sensors
+        }
+
+        const std::size_t first = i * party_size;
+        const bool aoe_pending = aoe_timer[i] > 0.0f;
+
+        for (std::uint32_t slot = 0; slot < party_size; ++slot)
+        {
+            const std::size_t a = first + slot;
+            float *row = sensors + a * sensor_count;
+
+            const float dx = boss_x[i] - pos_x[a];
+            const float dy = boss_y[i] - pos_y[a];
+            row[0] = dx * inv;
+            row[1] = dy * inv;
+            row[2] = std::sqrt(dx * dx + dy * dy) * inv * 0.5f;
+            row[3] = hp[a] / config.stats(role[a]).max_hp;
+            row[4] = boss_hp[i] / config.boss_hp;
+            row[5] = cooldown[a] <= 0.0f ? 1.0f : 0.0f;
+            row[6] = boss_target[i] == slot ? 1.0f : 0.0f;
+            row[7] = aoe_pending ? 1.0f : 0.0f;
+            row[8] = aoe_pending ? (aoe_x[i] - pos_x[a]) * inv : 0.0f;
+            row[9] = aoe_pending ? (aoe_y[i] - pos_y[a]) * inv : 0.0f;
+
+            // Most hurt living ally - the healer's job, and a hint for everyone else to stay close.
+            std::size_t lowest = a;
+            float lowest_fraction = 1.0f;
+            for (std::uint32_t other = 0; other < party_size; ++other)
+            {
+                const std::size_t b = first + other;
+                const float fraction = hp[b] / config.stats(role[b]).max_hp;
+                if (b != a && hp[b] > 0.0f && fraction < lowest_fraction)
+                {
+                    lowest = b;
+                    lowest_fraction = fraction;
+                }
+            }
+            row[10] = lowest_fraction;
+            row[11] = (pos_x[lowest] - pos_x[a]) * inv;
+            row[12] = (pos_y[lowest] - pos_y[a]) * inv;
+
+            row[13] = role[a] == Role::Tank ? 1.0f : 0.0f;
+            row[14] = role[a] == Role::Healer ? 1.0f : 0.0f;
+            row[15] = role[a] == Role::Dps ? 1.0f : 0.0f;
+
+            // Proximity, through the grid: how crowded it is here, and where the closest living ally stands. One
+            // radius query usually answers both; only an agent with nobody in reach needs the outward search.
+            auto living_ally = [&](std::uint32_t b) { return b != a && active[b] != 0.0f; };
+            std::uint32_t nearby = 0;
+            std::uint32_t closest = 0;
+            float closest_distance = std::numeric_limits<float>::infinity();
+            grid.forEachInRadius(static_cast<std::uint32_t>(i), pos_x[a], pos_y[a], config.ally_radius,
+                                 [&](std::uint32_t b, float distance_squared) {
+                                     if (living_ally(b))
+                                     {
+                                         ++nearby;
+                                         if (distance_squared < closest_distance)
+                                         {
+                                             closest = b;
+                                             closest_distance = distance_squared;
+                                         }
+                                     }
+                                 });
+            const bool any =
+                nearby > 0 || grid.nearest(static_cast<std::uint32_t>(i), pos_x[a], pos_y[a], 1, &closest, living_ally);
+
+            row[16] = party_size > 1 ? static_cast<float>(nearby) / (party_size - 1) : 0.0f;
+            row[17] = any ? (pos_x[closest] - pos_x[a]) * inv : 0.0f;
+            row[18] = any ? (pos_y[closest] - pos_y[a]) * inv : 0.0f;
+        }
+    }
+}
+
+void EncounterWorld::applyControls(const float *controls)
+{
+
+    for (std::size_t a = 0; a < role.size(); ++a)
+    {
+        const float *row = controls + a * control_count;
+        move_x[a] = row[0] * 2.0f - 1.0f;
+        move_y[a] = row[1] * 2.0f - 1.0f;
+        act[a] = row[2] > 0.5f ? 1 : 0;
+    }
+}
+
+void EncounterWorld::step()
+{
+
+    if (running_count == 0)
+    {
+        return;
+    }
+
+    integrate();
+    tickCooldowns();
+    useAbilities();
+    updateBosses();
+
+    ++ticks;
+    updateLiveness();
+
+    grid.build(pos_x.data(), pos_y.data(), role.size(), agent_instance.data());
+}
+
+void EncounterWorld::integrate()
+{
+
+    const float dt = config.dt;
+    const float h = config.arena_half_size;
+    const float speeds[3] = {config.tank.speed, config.healer.speed, config.dps.speed};
+
+    // Dead agents and finished instances have active = 0, so they stay put without a branch.
+    for (std::size_t a = 0; a < role.size(); ++a)
+    {
+        const float length = std::sqrt(move_x[a] * move_x[a] + move_y[a] * move_y[a]);
+        const float scale = speeds[static_cast<int>(role[a])] * active[a] / std::max(1.0f, length);
+        vel_x[a] = move_x[a] * scale;
+        vel_y[a] = move_y[a] * scale;
+    }
+
+    for (std::size_t a = 0; a < role.size(); ++a)
+    {
+        pos_x[a] = std::clamp(pos_x[a] + vel_x[a] * dt, -h, h);
+        pos_y[a] = std::clamp(pos_y[a] + vel_y[a] * dt, -h, h);
+    }
+}
+
+void EncounterWorld::tickCooldowns()
+{
+
+    const float dt = config.dt;
+    for (float &remaining : cooldown)
+    {
+        remaining = std::max(0.0f, remaining - dt);
+    }
+}
+
+void EncounterWorld::useAbilities()
+{
+
+    for (std::size_t i = 0; i < instance_count; ++i)
+    {
+        if (done[i])
+        {
+            continue;
+        }
+
+        const std::size_t first = i * party_size;
+        for (std::size_t a = first; a < first + party_size; ++a)
+        {
+            if (!act[a] || active[a] == 0.0f || cooldown[a] > 0.0f)
+            {
+                continue;
+            }
+
+            const RoleStats &stats = config.stats(role[a]);
+
+            if (role[a] == Role::Healer)
+            {
+                // Most hurt living party member in range, the healer included
+                std::size_t patient = a;
+                float patient_fraction = 1.0f;
+                for (std::size_t b = first; b < first + party_size; ++b)
+                {
+                    const float dx = pos_x[b] - pos_x[a];
+                    const float dy = pos_y[b] - pos_y[a];
+                    const float fraction = hp[b] / config.stats(role[b]).max_hp;
+                    if (hp[b] > 0.0f && fraction < patient_fraction && dx * dx + dy * dy <= stats.range * stats.range)
+                    {
+                        patient = b;
+                        patient_fraction = fraction;
+                    }
+                }
+
+                if (patient_fraction < 1.0f)
+                {
+                    const float healed = std::min(stats.power, config.stats(role[patient]).max_hp - hp[patient]);
+                    hp[patient] += healed;
+                    threat[a] += healed * stats.threat;
+                    cooldown[a] = stats.cooldown;
+                }
+            }
+            else
+            {
+                const float dx = boss_x[i] - pos_x[a];
+                const float dy = boss_y[i] - pos_y[a];
+                if (dx * dx + dy * dy <= stats.range * stats.range)
+                {
+                    boss_hp[i] = std::max(0.0f, boss_hp[i] - stats.power);
+                    threat[a] += stats.power * stats.threat;
+                    cooldown[a] = stats.cooldown;
+                }
+            }
+        }
+    }
+}
+
+void EncounterWorld::updateBosses()
+{
+
+    const float dt = config.dt;
+
+    for (std::size_t i = 0; i < instance_count; ++i)
+    {
+        if (done[i])
+        {
+            continue;
+        }
+
+        const std::size_t first = i * party_size;
+
+        // Highest threat among the living
+        std::size_t target = first + party_size;
+        for (std::size_t a = first; a < first + party_size; ++a)
+        {
+            if (active[a] != 0.0f && (target == first + party_size || threat[a] > threat[target]))
+            {
+                target = a;
+            }
+        }
+        if (target == first + party_size)
+        {
+            continue; // Wiped; updateLiveness() ends the instance
+        }
+        boss_target[i] = static_cast<std::uint32_t>(target - first);
+
+        // Close to a bit inside melee range, then stand and swing.
+        const float dx = pos_x[target] - boss_x[i];
+        const float dy = pos_y[target] - boss_y[i];
+        const float distance = std::sqrt(dx * dx + dy * dy);
+        const float stand_off = config.boss_melee_range * 0.8f;
+        if (distance > stand_off)
+        {
+            const float travel = std::min(config.boss_speed * dt, distance - stand_off);
+            boss_x[i] += dx / distance * travel;
+            boss_y[i] += dy / distance * travel;
+        }
+
+        boss_attack_timer[i] = std::max(0.0f, boss_attack_timer[i] - dt);
+        if (boss_attack_timer[i] == 0.0f && distance <= config.boss_melee_range)
+        {
+            hp[target] -= config.boss_melee_damage;
+            boss_attack_timer[i] = config.boss_attack_period;
+        }
+
+        // Ground AoE: mark the target's spot, then hit everyone who didn't get out in time.
+        if (aoe_timer[i] > 0.0f)
+        {
+            aoe_timer[i] -= dt;
+            if (aoe_timer[i] <= 0.0f)
+            {
+                aoe_timer[i] = 0.0f;
+                const float radius_squared = config.boss_aoe_radius * config.boss_aoe_radius;
+                for (std::size_t a = first; a < first + party_size; ++a)
+                {
+                    const float ax = pos_x[a] - aoe_x[i];
+                    const float ay = pos_y[a] - aoe_y[i];
+                    if (active[a] != 0.0f && ax * ax + ay * ay <= radius_squared)
+                    {
+                        hp[a] -= config.boss_aoe_damage;
+                    }
+                }
+            }
+        }
+        else
+        {
+            boss_aoe_cycle[i] -= dt;
+            if (boss_aoe_cycle[i] <= 0.0f)
+            {
+                aoe_x[i] = pos_x[target];
+                aoe_y[i] = pos_y[target];
+                aoe_timer[i] = config.boss_aoe_warning;
+                boss_aoe_cycle[i] = config.boss_aoe_period;
+            }
+        }
+    }
+}
+
+void EncounterWorld::updateLiveness()
+{
+
+    for (float &health : hp)
+    {
+        health = std::max(0.0f, health);
+    }
+
+    for (std::size_t i = 0; i < instance_count; ++i)
+    {
+        if (done[i])
+        {
+            continue;
+        }
+
+        const std::size_t first = i * party_size;
+        std::uint32_t alive = 0;
+        for (std::size_t a = first; a < first + party_size; ++a)
+        {
+            active[a] = hp[a] > 0.0f ? 1.0f : 0.0f;
+            alive += hp[a] > 0.0f ? 1 : 0;
+        }
+
+        if (boss_hp[i] <= 0.0f || alive == 0 || ticks >= config.max_ticks)
+        {
+            done[i] = 1;
+            finish_tick[i] = ticks;
+            --running_count;
+            std::fill(active.begin() + first, active.begin() + first + party_size, 0.0f);
+        }
+    }
+}
+
+float EncounterWorld::score(std::size_t instance) const
+{
+
+    const std::size_t first = instance * party_size;
+    std::uint32_t alive = 0;
+    for (std::size_t a = first; a < first + party_size; ++a)
+    {
+        alive += hp[a] > 0.0f ? 1 : 0;
+    }
+
+    // Survival only counts alongside damage, otherwise running from the boss for the whole fight pays off.
+    const float dealt = 1.0f - boss_hp[instance] / config.boss_hp;
+    const float survived = static_cast<float>(alive) / party_size;
+    float score = 100.0f * dealt + 30.0f * survived * dealt;
+
+    if (boss_hp[instance] <= 0.0f)
+    {
+        score += 100.0f * (2.0f - static_cast<float>(finish_tick[instance]) / config.max_ticks);
+    }
+    return score;
+}
+
+EncounterRunner::EncounterRunner(const EncounterConfig &config) : config(config) {}
+
+void EncounterRunner::start(std::vector<neat::Network> networks, neat::Rng &rng)
+{
+
+    this->networks = std::move(networks);
+
+    if (!world || world->instanceCount() != this->networks.size())
+    {
+        world.emplace(config, this->networks.size());
+        sensors.assign(world->agentCount() * EncounterWorld::sensor_count, 0.0f);
+        controls.assign(world->agentCount() * EncounterWorld::control_count, 0.5f);
+    }
+    world->reset(rng);
+
+    // The whole party shares its instance's network, so one lane per member. (A party bigger than a batch falls
+    // back to activating members one at a time.)
+    const std::uint32_t party = world->partySize();
+    batches.clear();
+    if (party <= neat::NetworkBatch::lanes)
+    {
+        batches.reserve(this->networks.size());
+        for (const neat::Network &network : this->networks)
+        {
+            assert(network.numInputs() == EncounterWorld::sensor_count);
+            assert(network.numOutputs() == EncounterWorld::control_count);
+
+            const neat::Network *members[neat::NetworkBatch::lanes];
+            std::fill(members, members + party, &network);
+            batches.emplace_back(members, party);
+        }
+    }
+}
+
+void EncounterRunner::copyActivations(std::size_t instance, std::uint32_t slot, std::vector<float> &out) const
+{
+
+    if (!batches.empty())
+    {
+        const neat::NetworkBatch &batch = batches[instance];
+        out.resize(batch.valueCount());
+        batch.laneActivations(slot, out.data());
+    }
+    else
+    {
+        out = networks[instance].activations();
+    }
+}
+
+bool EncounterRunner::step()
+{
+
+    if (!world || world->allFinished())
+    {
+        return false;
+    }
+
+    world->gatherSensors(sensors.data());
+
+    const std::uint32_t party = world->partySize();
+    for (std::size_t i = 0; i < networks.size(); ++i)
+    {
+        if (world->finished(i))
+        {
+            continue;
+        }
+
+        const std::size_t first = i * party;
+        if (!batches.empty())
+        {
+            batches[i].activate(&sensors[first * EncounterWorld::sensor_count],
+                                &controls[first * EncounterWorld::control_count]);
+        }
+        else
+        {
+            for (std::size_t a = first; a < first + party; ++a)
+            {
+                networks[i].activate(&sensors[a * EncounterWorld::sensor_count],
+                                     &controls[a * EncounterWorld::control_count]);
+            }
+        }
+    }
+
+    world->applyControls(controls.data());
+    world->step();
+    return !world->allFinished();
+}
+
+void playEncounters(const EncounterConfig &config, std::vector<neat::Network> &networks, neat::Rng &rng,
+                    float *fitness)
+{
+
+    const std::size_t count = networks.size();
+
+    EncounterRunner runner(config);
+    runner.start(std::move(networks), rng);
+    while (runner.step())
+    {
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        fitness[i] = runner.getWorld().score(i);
+    }
+}
+
+} // namespace sim
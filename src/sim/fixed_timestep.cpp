@@ -0,0 +1,42 @@
+#include "sim/fixed_timestep.hpp"
+
+namespace sim {
+
+FixedTimestep::FixedTimestep(double tick_rate_hz) : tick_seconds(1.0 / tick_rate_hz) {}
+
+void FixedTimestep::setSpeed(SimSpeed new_speed)
+{
+
+    // Leftover time from the old speed would otherwise be replayed at the new one.
+    accumulator = 0.0;
+    speed = new_speed;
+}
+
+double FixedTimestep::speedMultiplier() const
+{
+
+    switch (speed)
+    {
+    case SimSpeed::Paused:
+        return 0.0;
+    case SimSpeed::Fast:
+        return fast_multiplier;
+    default:
+        return 1.0;
+    }
+}
+
+void FixedTimestep::recordTicks(std::uint64_t ticks, double elapsed_seconds)
+{
+
+    if (elapsed_seconds <= 0.0)
+    {
+        return;
+    }
+
+    // Exponential moving average, so the readout in the GUI doesn't flicker frame to frame.
+    const double rate = ticks / elapsed_seconds;
+    measured_rate += (rate - measured_rate) * 0.05;
+}
+
+} // namespace sim
@@ -0,0 +1,173 @@
+#include "sim/metric_store.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace sim {
+
+namespace {
+
+constexpr std::uint64_t ring_mask = MetricSeries::level_capacity - 1;
+static_assert((MetricSeries::level_capacity & ring_mask) == 0, "level_capacity must be a power of two");
+
+} // namespace
+
+MetricSeries::MetricSeries() : levels(level_count)
+{
+
+    std::uint64_t bucket_size = 1;
+    for (Level &level : levels)
+    {
+        level.ring.resize(level_capacity);
+        level.bucket_size = bucket_size;
+        bucket_size *= fan_out;
+    }
+}
+
+void MetricSeries::append(float value)
+{
+
+    ++total;
+
+    // A finished bucket goes into its level's ring and is folded into the partial of the level above, which
+    // finishes in turn every fan_out buckets - amortised O(1) per sample.
+    Range finished{value, value};
+    for (std::size_t k = 0; k < levels.size(); ++k)
+    {
+        Level &level = levels[k];
+        level.ring[level.completed & ring_mask] = finished;
+        ++level.completed;
+
+        if (k + 1 == levels.size())
+        {
+            break;
+        }
+
+        Level &above = levels[k + 1];
+        if (above.partial_count == 0)
+        {
+            above.partial = finished;
+        }
+        else
+        {
+            above.partial.min = std::min(above.partial.min, finished.min);
+            above.partial.max = std::max(above.partial.max, finished.max);
+        }
+
+        if (++above.partial_count < fan_out)
+        {
+            break;
+        }
+        finished = above.partial;
+        above.partial_count = 0;
+    }
+}
+
+float MetricSeries::latest() const
+{
+
+    // Level 0 buckets are single samples, so the newest one is exact.
+    const Level &raw = levels.front();
+    return raw.completed == 0 ? 0.0f : raw.ring[(raw.completed - 1) & ring_mask].min;
+}
+
+void MetricSeries::downsample(std::uint64_t first, std::uint64_t last, std::size_t max_buckets,
+                              std::vector<MetricBucket> &out) const
+{
+
+    out.clear();
+    last = std::min(last, total);
+    if (first >= last)
+    {
+        return;
+    }
+    max_buckets = std::max<std::size_t>(1, max_buckets);
+
+    // Finest level where the span fits in max_buckets and `first` hasn't been overwritten yet; failing that the
+    // coarsest, starting from the oldest bucket it still has.
+    std::size_t k = 0;
+    for (; k + 1 < levels.size(); ++k)
+    {
+        const Level &level = levels[k];
+        const std::uint64_t oldest = level.completed > level_capacity ? level.completed - level_capacity : 0;
+        const std::uint64_t span = (last - first + level.bucket_size - 1) / level.bucket_size;
+        if (span <= max_buckets && oldest * level.bucket_size <= first)
+        {
+            break;
+        }
+    }
+
+    const Level &level = levels[k];
+    const std::uint64_t oldest = level.completed > level_capacity ? level.completed - level_capacity : 0;
+    const std::uint64_t from = std::max(first / level.bucket_size, oldest);
+    const std::uint64_t to = std::min((last + level.bucket_size - 1) / level.bucket_size, level.completed);
+
+    for (std::uint64_t b = from; b < to; ++b)
+    {
+        const Range &range = level.ring[b & ring_mask];
+        out.push_back({b * level.bucket_size, level.bucket_size, range.min, range.max});
+    }
+
+    // Samples after the last whole bucket at this level are spread over the partials of the levels below it.
+    const std::uint64_t tail_first = level.completed * level.bucket_size;
+    if (tail_first < last)
+    {
+        MetricBucket tail{tail_first, total - tail_first, 0.0f, 0.0f};
+        bool any = false;
+        for (std::size_t j = 1; j <= k; ++j)
+        {
+            const Level &below = levels[j];
+            if (below.partial_count == 0)
+            {
+                continue;
+            }
+            tail.min = any ? std::min(tail.min, below.partial.min) : below.partial.min;
+            tail.max = any ? std::max(tail.max, below.partial.max) : below.partial.max;
+            any = true;
+        }
+        if (any)
+        {
+            out.push_back(tail);
+        }
+    }
+}
+
+MetricStore::MetricStore(std::vector<std::string> names) : names(std::move(names)), series(this->names.size()) {}
+
+void MetricStore::appendRows(const std::vector<float> &samples)
+{
+
+    const std::size_t width = names.size();
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::size_t row = 0; row + width <= samples.size(); row += width)
+    {
+        for (std::size_t s = 0; s < width; ++s)
+        {
+            series[s].append(samples[row + s]);
+        }
+    }
+}
+
+std::uint64_t MetricStore::size() const
+{
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return series.empty() ? 0 : series.front().size();
+}
+
+float MetricStore::latest(std::size_t index) const
+{
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return series.at(index).latest();
+}
+
+void MetricStore::downsample(std::size_t index, std::uint64_t first, std::uint64_t last, std::size_t max_buckets,
+                             std::vector<MetricBucket> &out) const
+{
+
+    std::lock_guard<std::mutex> lock(mutex);
+    series.at(index).downsample(first, last, max_buckets, out);
+}
+
+} // namespace sim
@@ -0,0 +1,100 @@
+#include "sim/simulation.hpp"
+
+#include "neat_core/profiler.hpp"
+
+#include <utility>
+
+namespace sim {
+
+namespace {
+
+SimulationConfig fitToTask(SimulationConfig config)
+{
+
+    if (config.task == Task::Encounter)
+    {
+        config.population.num_inputs = EncounterWorld::sensor_count;
+        config.population.num_outputs = EncounterWorld::control_count;
+    }
+    else
+    {
+        config.population.num_inputs = 2;
+        config.population.num_outputs = 1;
+    }
+    return config;
+}
+
+neat::FitnessEvaluator makeEvaluator(neat::ThreadPool &pool, const SimulationConfig &config)
+{
+
+    if (config.task == Task::Xor)
+    {
+        return neat::FitnessEvaluator(pool, neat::xorEpisode);
+    }
+
+    // A batch of genomes shares one EncounterWorld, so each tick is a few sweeps over every party in the batch.
+    const EncounterConfig encounter = config.encounter;
+    return neat::FitnessEvaluator(
+        pool,
+        [encounter](std::vector<neat::Network> &networks, neat::Rng &rng, float *fitness) {
+            playEncounters(encounter, networks, rng, fitness);
+        },
+        config.encounter_batch);
+}
+
+} // namespace
+
+Simulation::Simulation(const SimulationConfig &config)
+    : config(fitToTask(config)), pool(config.threads), evaluator(makeEvaluator(pool, this->config)),
+      population(this->config.population, &pool), showcase(this->config.encounter)
+{
+    startShowcase();
+}
+
+void Simulation::tick()
+{
+
+    NEAT_PROFILE_SCOPE("tick");
+
+    ++total_ticks;
+    ++showcase_tick;
+    showcase.step();
+
+    if (showcase_tick >= config.showcase_ticks)
+    {
+        population.epoch(evaluator);
+        showcase_tick = 0;
+        startShowcase();
+    }
+}
+
+void Simulation::restore(const neat::CheckpointView &checkpoint)
+{
+
+    population.restore(checkpoint);
+    showcase_tick = 0;
+    startShowcase();
+}
+
+void Simulation::startShowcase()
+{
+
+    if (!config.showcase || config.task != Task::Encounter)
+    {
+        return;
+    }
+
+    NEAT_PROFILE_SCOPE("start showcase");
+
+    std::vector<neat::Network> networks;
+    networks.reserve(population.size());
+    for (const neat::Genome &genome : population.getGenomes())
+    {
+        networks.push_back(neat::Network::compile(genome));
+    }
+
+    neat::Rng rng = neat::Rng::stream(population.seed(), neat::RngStream::Showcase, population.generation());
+    showcase.start(std::move(networks), rng);
+}
+
+} // namespace sim
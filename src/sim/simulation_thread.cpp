@@ -0,0 +1,312 @@
+#include "sim/simulation_thread.hpp"
+
+#include "neat_core/profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace sim {
+
+SimulationThread::SimulationThread(const SimulationConfig &config)
+    : simulation(config), clock(60.0),
+      metrics({"Boss HP", "Party HP", "Tank threat", "Healer threat", "DPS threat", "Reward"})
+{
+    publishSnapshot(); // So the GUI has something to show before the worker's first batch
+}
+
+SimulationThread::~SimulationThread() { stop(); }
+
+void SimulationThread::start()
+{
+
+    if (worker.joinable())
+    {
+        return;
+    }
+
+    stop_requested = false;
+    worker = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop()
+{
+
+    stop_requested = true;
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+const SimSnapshot &SimulationThread::latestSnapshot()
+{
+
+    snapshots.update();
+    return snapshots.readBuffer();
+}
+
+const WorldFrame &SimulationThread::latestWorld()
+{
+
+    frames.update();
+    return frames.readBuffer();
+}
+
+const NetworkTopology &SimulationThread::latestTopology()
+{
+
+    topologies.update();
+    return topologies.readBuffer();
+}
+
+const ActivationFrame &SimulationThread::latestActivations()
+{
+
+    activations.update();
+    return activations.readBuffer();
+}
+
+void SimulationThread::run()
+{
+
+    using Clock = FixedTimestep::Clock;
+    neat::Profiler::setThreadName("sim");
+
+    // Unbounded mode comes up for air this often to publish a snapshot and check for controls.
+    const auto batch_period = std::chrono::milliseconds(8);
+
+    auto last = Clock::now();
+    while (!stop_requested.load(std::memory_order_acquire))
+    {
+        applyControls();
+
+        const auto now = Clock::now();
+        const double elapsed = std::chrono::duration<double>(now - last).count();
+        last = now;
+
+        const std::uint64_t generation = simulation.getPopulation().generation();
+        clock.advance(elapsed, now + batch_period, [this] {
+            simulation.tick();
+            sampleMetrics();
+        });
+
+        // Breeding blocks its tick for a whole generation. That time isn't owed to the showcase, so don't let
+        // the next batch replay it (or hit the catch-up cap).
+        if (simulation.getPopulation().generation() != generation)
+        {
+            last = Clock::now();
+        }
+        publishSnapshot();
+
+        // Bounded speeds only owe a few ticks per millisecond, so sleep rather than spin on the accumulator.
+        if (clock.getSpeed() != SimSpeed::Unbounded)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void SimulationThread::applyControls()
+{
+
+    const SimSpeed speed = requested_speed.load(std::memory_order_relaxed);
+    if (speed != clock.getSpeed())
+    {
+        clock.setSpeed(speed);
+    }
+    clock.setFastMultiplier(requested_multiplier.load(std::memory_order_relaxed));
+}
+
+void SimulationThread::publishSnapshot()
+{
+
+    NEAT_PROFILE_SCOPE("publish");
+
+    const neat::Population &population = simulation.getPopulation();
+
+    SimSnapshot &snapshot = snapshots.writeBuffer();
+    snapshot.generation = population.generation();
+    snapshot.total_ticks = simulation.totalTicks();
+    snapshot.showcase_tick = simulation.showcaseTick();
+    snapshot.showcase_ticks = simulation.showcaseTicks();
+    snapshot.best_fitness = population.bestFitness();
+    snapshot.species_count = population.getSpecies().size();
+    snapshot.ticks_per_second = clock.ticksPerSecond();
+    snapshot.speed = clock.getSpeed();
+    snapshot.fast_multiplier = clock.getFastMultiplier();
+
+    snapshots.publish();
+
+    publishTopology();
+
+    // Handed over once per batch rather than per tick, so the GUI's queries rarely contend for the lock.
+    if (!pending_metrics.empty())
+    {
+        metrics.appendRows(pending_metrics);
+        pending_metrics.clear();
+    }
+
+    if (const EncounterWorld *world = simulation.showcaseWorld())
+    {
+        publishWorld(*world);
+        publishActivations(*simulation.showcaseRunner());
+    }
+}
+
+void SimulationThread::publishTopology()
+{
+
+    const neat::Population &population = simulation.getPopulation();
+    if (population.size() == 0)
+    {
+        return;
+    }
+
+    const std::size_t genome = std::min(requested_genome.load(std::memory_order_relaxed), population.size() - 1);
+    if (population.generation() == topology_generation && genome == topology_genome)
+    {
+        return;
+    }
+    topology_generation = population.generation();
+    topology_genome = genome;
+
+    const neat::Genome &source = population.getGenomes()[genome];
+
+    NetworkTopology &topology = topologies.writeBuffer();
+    topology.version = ++topology_version;
+    topology.generation = population.generation();
+    topology.genome = genome;
+    topology.genome_count = population.size();
+    topology.num_inputs = source.numInputs();
+    topology.num_outputs = source.numOutputs();
+    topology.node_types.assign(source.nodeTypes().begin(), source.nodeTypes().end());
+
+    const std::size_t edges = source.connectionCount();
+    topology.edge_in.resize(edges);
+    topology.edge_out.resize(edges);
+    for (std::size_t c = 0; c < edges; ++c)
+    {
+        topology.edge_in[c] = static_cast<std::uint32_t>(source.nodeIndex(source.connectionIn()[c]));
+        topology.edge_out[c] = static_cast<std::uint32_t>(source.nodeIndex(source.connectionOut()[c]));
+    }
+    topology.edge_weight.assign(source.connectionWeights().begin(), source.connectionWeights().end());
+    topology.edge_enabled.assign(source.connectionEnabled().begin(), source.connectionEnabled().end());
+
+    topologies.publish();
+}
+
+void SimulationThread::publishActivations(const EncounterRunner &runner)
+{
+
+    // Same genome as the published topology, so the viewer can line the values up with its nodes.
+    const EncounterWorld &world = runner.getWorld();
+    if (topology_genome >= world.instanceCount())
+    {
+        return;
+    }
+    const std::uint32_t party = world.partySize();
+    const std::uint32_t slot = std::min(requested_slot.load(std::memory_order_relaxed), party - 1);
+
+    ActivationFrame &frame = activations.writeBuffer();
+    frame.generation = simulation.getPopulation().generation();
+    frame.genome = topology_genome;
+    frame.tick = world.tickCount();
+    frame.slot = slot;
+
+    const std::size_t first = topology_genome * party;
+    frame.party.assign(world.roles().begin() + first, world.roles().begin() + first + party);
+    runner.copyActivations(topology_genome, slot, frame.values);
+
+    activations.publish();
+}
+
+void SimulationThread::sampleMetrics()
+{
+
+    const EncounterWorld *world = simulation.showcaseWorld();
+    if (!world || world->instanceCount() == 0)
+    {
+        return;
+    }
+
+    const EncounterConfig &config = world->getConfig();
+    const std::size_t instances = world->instanceCount();
+    const std::size_t agents = world->agentCount();
+
+    float boss_health = 0.0f;
+    float reward = 0.0f;
+    for (std::size_t i = 0; i < instances; ++i)
+    {
+        boss_health += world->bossHealth()[i] / config.boss_hp;
+        reward += world->score(i);
+    }
+
+    float party_health = 0.0f;
+    float threat[3] = {0.0f, 0.0f, 0.0f};
+    for (std::size_t a = 0; a < agents; ++a)
+    {
+        const Role role = world->roles()[a];
+        party_health += std::max(0.0f, world->health()[a]) / config.stats(role).max_hp;
+        threat[static_cast<int>(role)] += world->threats()[a];
+    }
+    const float total_threat = threat[0] + threat[1] + threat[2];
+    const float threat_scale = total_threat > 0.0f ? 1.0f / total_threat : 0.0f;
+
+    const std::size_t row = pending_metrics.size();
+    pending_metrics.resize(row + encounter_metric_count);
+    pending_metrics[row + BossHealth] = boss_health / instances;
+    pending_metrics[row + PartyHealth] = party_health / agents;
+    pending_metrics[row + TankThreat] = threat[static_cast<int>(Role::Tank)] * threat_scale;
+    pending_metrics[row + HealerThreat] = threat[static_cast<int>(Role::Healer)] * threat_scale;
+    pending_metrics[row + DpsThreat] = threat[static_cast<int>(Role::Dps)] * threat_scale;
+    pending_metrics[row + Reward] = reward / instances;
+}
+
+void SimulationThread::publishWorld(const EncounterWorld &world)
+{
+
+    WorldFrame &frame = frames.writeBuffer();
+    frame.generation = simulation.getPopulation().generation();
+    frame.tick = world.tickCount();
+    frame.instance_count = world.instanceCount();
+    frame.party_size = world.partySize();
+    frame.arena_half_size = world.getConfig().arena_half_size;
+    frame.aoe_radius = world.getConfig().boss_aoe_radius;
+
+    frame.role = world.roles();
+    frame.x = world.positionsX();
+    frame.y = world.positionsY();
+    frame.boss_x = world.bossX();
+    frame.boss_y = world.bossY();
+    frame.aoe_x = world.aoeX();
+    frame.aoe_y = world.aoeY();
+    frame.aoe_timer = world.aoeTimers();
+
+    const std::size_t agents = world.agentCount();
+    frame.heading.resize(agents);
+    frame.health.resize(agents);
+    for (std::size_t a = 0; a < agents; ++a)
+    {
+        const std::size_t instance = a / frame.party_size;
+        float dx = world.velocitiesX()[a];
+        float dy = world.velocitiesY()[a];
+        if (dx == 0.0f && dy == 0.0f)
+        {
+            dx = frame.boss_x[instance] - frame.x[a];
+            dy = frame.boss_y[instance] - frame.y[a];
+        }
+        frame.heading[a] = std::atan2(dy, dx);
+        frame.health[a] = world.health()[a] / world.getConfig().stats(frame.role[a]).max_hp;
+    }
+
+    frame.boss_health.resize(frame.instance_count);
+    for (std::size_t i = 0; i < frame.instance_count; ++i)
+    {
+        frame.boss_health[i] = world.bossHealth()[i] / world.getConfig().boss_hp;
+    }
+
+    frames.publish();
+}
+
+} // namespace sim
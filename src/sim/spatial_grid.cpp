@@ -0,0 +1,60 @@
+#include "sim/spatial_grid.hpp"
+
+#include <stdexcept>
+
+namespace sim {
+
+SpatialGrid::SpatialGrid(float min_x, float min_y, float max_x, float max_y, float cell_size, std::uint32_t layers)
+    : min_x(min_x), min_y(min_y), cell_size(cell_size), inv_cell(1.0f / cell_size), layer_count(layers)
+{
+
+    if (!(cell_size > 0.0f) || !(max_x > min_x) || !(max_y > min_y) || layers == 0)
+    {
+        throw std::runtime_error("SpatialGrid: empty rectangle, cell size or layer count");
+    }
+
+    cells_x = std::max(1u, static_cast<std::uint32_t>(std::ceil((max_x - min_x) * inv_cell)));
+    cells_y = std::max(1u, static_cast<std::uint32_t>(std::ceil((max_y - min_y) * inv_cell)));
+    cell_start.assign(std::size_t(layers) * cells_x * cells_y + 1, 0);
+}
+
+void SpatialGrid::build(const float *xs, const float *ys, std::size_t count, const std::uint32_t *layers)
+{
+
+    point_cell.resize(count);
+    sorted_index.resize(count);
+    sorted_x.resize(count);
+    sorted_y.resize(count);
+    std::fill(cell_start.begin(), cell_start.end(), 0);
+
+    // Counting sort: histogram shifted by one, prefix sum, then scatter. cell_start[c] doubles as cell c's write
+    // cursor during the scatter, which leaves it holding the next cell's start - hence the shift back at the end.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::uint32_t layer = layers ? std::min(layers[i], layer_count - 1) : 0;
+        const std::size_t cell = cellIndex(layer, cellX(xs[i]), cellY(ys[i]));
+        point_cell[i] = static_cast<std::uint32_t>(cell);
+        ++cell_start[cell + 1];
+    }
+
+    for (std::size_t c = 1; c < cell_start.size(); ++c)
+    {
+        cell_start[c] += cell_start[c - 1];
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::uint32_t slot = cell_start[point_cell[i]]++;
+        sorted_index[slot] = static_cast<std::uint32_t>(i);
+        sorted_x[slot] = xs[i];
+        sorted_y[slot] = ys[i];
+    }
+
+    for (std::size_t c = cell_start.size() - 1; c > 0; --c)
+    {
+        cell_start[c] = cell_start[c - 1];
+    }
+    cell_start[0] = 0;
+}
+
+} // namespace sim
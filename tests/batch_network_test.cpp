@@ -0,0 +1,210 @@
+#include "test.hpp"
+
+#include "neat_core/batch_network.hpp"
+#include "neat_core/genome.hpp"
+#include "neat_core/innovation.hpp"
+#include "neat_core/network.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Lane-parallel activation (whichever of AVX2, SSE2 or scalar this build compiled) against Network::activate.
+// The vector exponential is a polynomial, so outputs agree to float rounding rather than bit for bit.
+
+namespace {
+
+constexpr std::uint32_t num_inputs = 5;
+constexpr std::uint32_t num_outputs = 3;
+constexpr float tolerance = 1e-5f;
+
+// A minimal genome grown to have hidden nodes, and `count` copies of it with different weights.
+std::vector<neat::Network> sameTopology(std::size_t count, neat::Rng &rng, neat::InnovationRegistry &registry,
+                                        int growth)
+{
+
+    neat::MutationConfig config;
+    neat::Genome genome = neat::Genome::minimal(num_inputs, num_outputs, rng, config);
+    for (int i = 0; i < growth; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            genome.mutateAddNode(rng, registry);
+        }
+        else
+        {
+            genome.mutateAddConnection(rng, registry, config);
+        }
+    }
+
+    config.weight_perturb_rate = 0.0f; // Replace every weight
+    std::vector<neat::Network> networks;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        neat::Genome variant = genome;
+        variant.mutateWeights(rng, config);
+        networks.push_back(neat::Network::compile(variant));
+    }
+    return networks;
+}
+
+std::vector<float> randomRows(std::size_t rows, std::size_t width, neat::Rng &rng)
+{
+    std::vector<float> values(rows * width);
+    for (float &value : values)
+    {
+        value = neat::randomFloat(rng, -2.0f, 2.0f);
+    }
+    return values;
+}
+
+} // namespace
+
+TEST_CASE(batch_network, lanes_match_scalar_activation)
+{
+
+    neat::Rng rng(31);
+    neat::InnovationRegistry registry(neat::Genome::minimalNodeCount(num_inputs, num_outputs),
+                                      neat::Genome::minimalInnovationCount(num_inputs, num_outputs));
+
+    // Every lane count from one (mostly idle) to a full batch, on a minimal and a grown topology.
+    for (const int growth : {0, 12})
+    {
+        for (std::size_t count = 1; count <= neat::NetworkBatch::lanes; ++count)
+        {
+            std::vector<neat::Network> networks = sameTopology(count, rng, registry, growth);
+            std::vector<const neat::Network *> pointers;
+            for (const neat::Network &network : networks)
+            {
+                pointers.push_back(&network);
+            }
+            neat::NetworkBatch batch(pointers.data(), pointers.size());
+            CHECK(batch.laneCount() == count);
+
+            bool outputs_match = true;
+            bool activations_match = true;
+            for (int step = 0; step < 3; ++step)
+            {
+                const std::vector<float> inputs = randomRows(count, num_inputs, rng);
+                std::vector<float> outputs(count * num_outputs);
+                batch.activate(inputs.data(), outputs.data());
+
+                std::vector<float> lane_values(batch.valueCount());
+                for (std::size_t lane = 0; lane < count; ++lane)
+                {
+                    float expected[num_outputs];
+                    networks[lane].activate(&inputs[lane * num_inputs], expected);
+                    for (std::uint32_t o = 0; o < num_outputs; ++o)
+                    {
+                        outputs_match = outputs_match &&
+                                        std::fabs(outputs[lane * num_outputs + o] - expected[o]) <= tolerance;
+                    }
+
+                    batch.laneActivations(lane, lane_values.data());
+                    const std::vector<float> &scalar_values = networks[lane].activations();
+                    activations_match = activations_match && scalar_values.size() == lane_values.size();
+                    for (std::size_t v = 0; activations_match && v < lane_values.size(); ++v)
+                    {
+                        activations_match = std::fabs(lane_values[v] - scalar_values[v]) <= tolerance;
+                    }
+                }
+            }
+            CHECK(outputs_match);
+            CHECK(activations_match);
+        }
+    }
+}
+
+TEST_CASE(batch_network, lane_rows_by_pointer)
+{
+
+    neat::Rng rng(32);
+    neat::InnovationRegistry registry(neat::Genome::minimalNodeCount(num_inputs, num_outputs),
+                                      neat::Genome::minimalInnovationCount(num_inputs, num_outputs));
+    std::vector<neat::Network> networks = sameTopology(5, rng, registry, 6);
+    std::vector<const neat::Network *> pointers;
+    for (const neat::Network &network : networks)
+    {
+        pointers.push_back(&network);
+    }
+    neat::NetworkBatch batch(pointers.data(), pointers.size());
+
+    // Rows in reverse order, as a caller with its own layout would pass them.
+    const std::vector<float> inputs = randomRows(5, num_inputs, rng);
+    std::vector<float> outputs(5 * num_outputs);
+    const float *lane_inputs[5];
+    float *lane_outputs[5];
+    for (std::size_t lane = 0; lane < 5; ++lane)
+    {
+        lane_inputs[lane] = &inputs[(4 - lane) * num_inputs];
+        lane_outputs[lane] = &outputs[(4 - lane) * num_outputs];
+    }
+    batch.activate(lane_inputs, lane_outputs);
+
+    bool outputs_match = true;
+    for (std::size_t lane = 0; lane < 5; ++lane)
+    {
+        float expected[num_outputs];
+        networks[lane].activate(lane_inputs[lane], expected);
+        for (std::uint32_t o = 0; o < num_outputs; ++o)
+        {
+            outputs_match = outputs_match && std::fabs(lane_outputs[lane][o] - expected[o]) <= tolerance;
+        }
+    }
+    CHECK(outputs_match);
+}
+
+TEST_CASE(batch_network, grouped_set_matches_scalar_activation)
+{
+
+    neat::Rng rng(33);
+    neat::InnovationRegistry registry(neat::Genome::minimalNodeCount(num_inputs, num_outputs),
+                                      neat::Genome::minimalInnovationCount(num_inputs, num_outputs));
+
+    // Groups of 1 (scalar), 3 (one partial batch), 8 (one full batch) and 11 (a full batch plus a partial one),
+    // interleaved so grouping has to gather members from all over the set.
+    std::vector<std::vector<neat::Network>> groups;
+    for (const std::size_t size : {1, 3, 8, 11})
+    {
+        groups.push_back(sameTopology(size, rng, registry, static_cast<int>(size) + 2));
+    }
+    std::vector<neat::Network> networks;
+    for (std::size_t i = 0; i < 11; ++i)
+    {
+        for (const std::vector<neat::Network> &group : groups)
+        {
+            if (i < group.size())
+            {
+                networks.push_back(group[i]);
+            }
+        }
+    }
+
+    neat::BatchedNetworks batched(networks);
+    CHECK(batched.batchCount() == 4); // 3, 8, 8 + 3
+    CHECK(batched.scalarCount() == 1);
+
+    bool outputs_match = true;
+    for (int step = 0; step < 3; ++step)
+    {
+        const std::vector<float> inputs = randomRows(networks.size(), num_inputs, rng);
+        std::vector<float> outputs(networks.size() * num_outputs, -1.0f);
+        batched.activate(inputs.data(), outputs.data());
+
+        for (std::size_t n = 0; n < networks.size(); ++n)
+        {
+            float expected[num_outputs];
+            networks[n].activate(&inputs[n * num_inputs], expected);
+            for (std::uint32_t o = 0; o < num_outputs; ++o)
+            {
+                outputs_match = outputs_match && std::fabs(outputs[n * num_outputs + o] - expected[o]) <= tolerance;
+            }
+        }
+    }
+    CHECK(outputs_match);
+
+    // min_batch above a group's size sends it down the scalar path instead.
+    neat::BatchedNetworks strict(networks, 9);
+    CHECK(strict.batchCount() == 1); // 8 of the 11; the 3 left over are under min_batch
+    CHECK(strict.scalarCount() == 1 + 3 + 8 + 3);
+}
@@ -0,0 +1,196 @@
+#include "test.hpp"
+
+#include "neat_core/checkpoint.hpp"
+#include "sim/simulation.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Files are written to the working directory (ctest runs in the build tree), one name per test.
+std::vector<char> readFile(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string &path, const std::vector<char> &bytes)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+template <class T> bool sameArray(const neat::ArrayView<T> &a, const neat::ArrayView<T> &b)
+{
+    return a.size == b.size && (a.size == 0 || std::memcmp(a.data, b.data, a.size * sizeof(T)) == 0);
+}
+
+sim::SimulationConfig xorConfig()
+{
+
+    sim::SimulationConfig config;
+    config.task = sim::Task::Xor;
+    config.population.size = 60;
+    config.population.seed = 5;
+    config.showcase_ticks = 1; // Breed every tick
+    config.threads = 2;
+    return config;
+}
+
+// A population a few generations in, so it has hidden nodes, several species and a moved-on RNG.
+neat::PopulationSnapshot evolvedSnapshot()
+{
+
+    sim::Simulation simulation(xorConfig());
+    for (int generation = 0; generation < 8; ++generation)
+    {
+        simulation.tick();
+    }
+    return simulation.getPopulation().snapshot();
+}
+
+// Writes `snapshot` after `corrupt` has had a go at it, and expects the file to be refused on open.
+template <class Corrupt> bool rejected(neat::PopulationSnapshot snapshot, const std::string &path, Corrupt corrupt)
+{
+
+    corrupt(snapshot);
+    neat::writeCheckpoint(snapshot.view(), path);
+    try
+    {
+        neat::MappedCheckpoint checkpoint(path);
+    }
+    catch (const std::runtime_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE(checkpoint, save_map_restore_round_trip)
+{
+
+    const neat::PopulationSnapshot saved = evolvedSnapshot();
+    const neat::CheckpointView original = saved.view();
+    neat::writeCheckpoint(original, "round_trip.ckpt");
+
+    neat::MappedCheckpoint mapped("round_trip.ckpt");
+    const neat::CheckpointView &view = mapped.view();
+
+    CHECK(view.seed == original.seed);
+    CHECK(view.generation == original.generation);
+    CHECK(view.num_inputs == original.num_inputs && view.num_outputs == original.num_outputs);
+    CHECK(view.next_node_id == original.next_node_id);
+    CHECK(view.next_innovation == original.next_innovation);
+    CHECK(view.next_species_id == original.next_species_id);
+    CHECK(view.best_fitness == original.best_fitness);
+    CHECK(sameArray(view.genomes, original.genomes));
+    CHECK(sameArray(view.node_ids, original.node_ids));
+    CHECK(sameArray(view.node_types, original.node_types));
+    CHECK(sameArray(view.conn_innovation, original.conn_innovation));
+    CHECK(sameArray(view.conn_in, original.conn_in));
+    CHECK(sameArray(view.conn_out, original.conn_out));
+    CHECK(sameArray(view.conn_weight, original.conn_weight));
+    CHECK(sameArray(view.conn_enabled, original.conn_enabled));
+    CHECK(sameArray(view.species, original.species));
+    CHECK(sameArray(view.members, original.members));
+    CHECK(sameArray(view.rng_state, original.rng_state));
+
+    // Restoring and snapshotting again gives back the same file, byte for byte.
+    sim::Simulation restored(xorConfig());
+    restored.restore(view);
+    CHECK(restored.getPopulation().generation() == original.generation);
+    CHECK(restored.getPopulation().size() == original.populationSize());
+
+    neat::writeCheckpoint(restored.getPopulation().snapshot().view(), "round_trip_again.ckpt");
+    const std::vector<char> first = readFile("round_trip.ckpt");
+    CHECK(!first.empty());
+    CHECK(first == readFile("round_trip_again.ckpt"));
+}
+
+TEST_CASE(checkpoint, rejects_unreadable_files)
+{
+
+    CHECK_THROWS(neat::MappedCheckpoint("no_such_file.ckpt"), std::runtime_error);
+
+    neat::writeCheckpoint(evolvedSnapshot().view(), "damaged.ckpt");
+    const std::vector<char> good = readFile("damaged.ckpt");
+
+    writeFile("damaged.ckpt", {});
+    CHECK_THROWS(neat::MappedCheckpoint("damaged.ckpt"), std::runtime_error);
+
+    // Truncated anywhere: the header's file size no longer matches.
+    for (const std::size_t keep : {std::size_t(16), good.size() / 2, good.size() - 1})
+    {
+        writeFile("damaged.ckpt", std::vector<char>(good.begin(), good.begin() + keep));
+        CHECK_THROWS(neat::MappedCheckpoint("damaged.ckpt"), std::runtime_error);
+    }
+
+    std::vector<char> bytes = good;
+    bytes[0] = 'X'; // Magic
+    writeFile("damaged.ckpt", bytes);
+    CHECK_THROWS(neat::MappedCheckpoint("damaged.ckpt"), std::runtime_error);
+
+    bytes = good;
+    bytes[8] ^= 0x7f; // Version, straight after the 8-byte magic
+    writeFile("damaged.ckpt", bytes);
+    CHECK_THROWS(neat::MappedCheckpoint("damaged.ckpt"), std::runtime_error);
+
+    bytes = good;
+    bytes.push_back(0); // Trailing junk
+    writeFile("damaged.ckpt", bytes);
+    CHECK_THROWS(neat::MappedCheckpoint("damaged.ckpt"), std::runtime_error);
+}
+
+TEST_CASE(checkpoint, rejects_genes_that_would_crash_on_resume)
+{
+
+    const neat::PopulationSnapshot good = evolvedSnapshot();
+    const std::string path = "bad_genes.ckpt";
+
+    // Each of these is otherwise a well-formed file.
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.conn_in[0] = 100000; }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.conn_out.back() = 100000; }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.conn_out[0] = s.node_ids[0]; })); // Into an input
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.node_types[0] = neat::NodeType(7); }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.node_types[0] = neat::NodeType::Hidden; }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { std::swap(s.node_ids[0], s.node_ids[1]); }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.genomes[0].node_count = 1; }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.genomes.back().first_connection = 1u << 30; }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.species[0].member_count = 0; }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.members[0] = 100000; }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.conn_weight.pop_back(); })); // Sizes disagree
+
+    // Species have to cover the population exactly once: none at all, a genome left out or one counted twice.
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) {
+        s.genomes.resize(s.genomes.size() - s.species.size()); // Drop the representatives along with the species
+        s.species.clear();
+        s.members.clear();
+    }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) { s.members[0] = s.members[1]; }));
+    CHECK(rejected(good, path, [](neat::PopulationSnapshot &s) {
+        // Drop the last member of the first species with two or more, shifting the species after it down.
+        std::size_t k = 0;
+        while (s.species[k].member_count < 2)
+        {
+            ++k;
+        }
+        --s.species[k].member_count;
+        s.members.erase(s.members.begin() + s.species[k].first_member + s.species[k].member_count);
+        for (++k; k < s.species.size(); ++k)
+        {
+            --s.species[k].first_member;
+        }
+    }));
+
+    // And the untouched snapshot still loads.
+    CHECK(!rejected(good, path, [](neat::PopulationSnapshot &) {}));
+}
@@ -0,0 +1,130 @@
+#include "test.hpp"
+
+#include "neat_core/checkpoint.hpp"
+#include "neat_core/checkpoint_writer.hpp"
+#include "neat_core/population.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NEAT_TEST_FIFO 1
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define NEAT_TEST_FIFO 0
+#endif
+
+namespace {
+
+// A fresh population's snapshot, stamped with `generation` so each file can be told apart.
+neat::PopulationSnapshot snapshotAt(std::uint64_t generation, std::size_t size = 40)
+{
+
+    neat::PopulationConfig config;
+    config.size = size;
+    neat::Population population(config);
+
+    neat::PopulationSnapshot snapshot = population.snapshot();
+    snapshot.header.generation = generation;
+    return snapshot;
+}
+
+std::uint64_t generationIn(const std::string &path)
+{
+    neat::MappedCheckpoint checkpoint(path);
+    return checkpoint.view().generation;
+}
+
+} // namespace
+
+TEST_CASE(checkpoint_writer, writes_and_replaces_in_place)
+{
+
+    const std::string path = "writer.ckpt";
+    neat::CheckpointWriter writer;
+
+    writer.submit(snapshotAt(7), path);
+    writer.flush();
+    CHECK(writer.written() == 1);
+    CHECK(writer.lastError().empty());
+    CHECK(generationIn(path) == 7);
+    CHECK(!std::filesystem::exists(path + ".tmp"));
+
+    // A later checkpoint renames over the earlier one.
+    writer.submit(snapshotAt(8), path);
+    writer.flush();
+    CHECK(writer.written() == 2);
+    CHECK(generationIn(path) == 8);
+    CHECK(!std::filesystem::exists(path + ".tmp"));
+}
+
+TEST_CASE(checkpoint_writer, failed_write_is_reported_and_leaves_nothing)
+{
+
+    const std::string path = "no_such_directory/writer.ckpt";
+    neat::CheckpointWriter writer;
+
+    writer.submit(snapshotAt(1), path);
+    writer.flush();
+    CHECK(writer.written() == 0);
+    CHECK(!writer.lastError().empty());
+    CHECK(!std::filesystem::exists(path));
+}
+
+TEST_CASE(checkpoint_writer, flush_waits_for_everything_queued)
+{
+
+    const std::string path = "writer_flush.ckpt";
+    neat::CheckpointWriter writer(8);
+    for (std::uint64_t generation = 1; generation <= 5; ++generation)
+    {
+        writer.submit(snapshotAt(generation), path);
+    }
+    writer.flush();
+
+    CHECK(writer.dropped() == 0); // The queue never held more than 8
+    CHECK(writer.written() == 5);
+    CHECK(generationIn(path) == 5);
+}
+
+#if NEAT_TEST_FIFO
+TEST_CASE(checkpoint_writer, full_queue_drops_the_oldest)
+{
+
+    // Holds the worker mid-write: the temporary file is a FIFO, so writing it blocks until the test reads it. The
+    // snapshot is bigger than a pipe's buffer, so opening the reader end doesn't let the write finish.
+    const std::string path = "writer_bounded.ckpt";
+    const std::string temporary = path + ".tmp";
+    std::filesystem::remove(temporary);
+    CHECK(::mkfifo(temporary.c_str(), 0600) == 0);
+
+    neat::CheckpointWriter writer(2);
+    writer.submit(snapshotAt(1, 20000), path);
+
+    const int reader = ::open(temporary.c_str(), O_RDONLY); // Returns once the worker has opened it to write
+    CHECK(reader >= 0);
+
+    // The worker is stuck on generation 1, so these queue up: 3 evicts 2 once the queue holds two.
+    writer.submit(snapshotAt(2), path);
+    writer.submit(snapshotAt(3), path);
+    writer.submit(snapshotAt(4), path);
+    CHECK(writer.dropped() == 1);
+
+    char buffer[4096];
+    while (::read(reader, buffer, sizeof(buffer)) > 0)
+    {
+    }
+    ::close(reader);
+    writer.flush();
+
+    // Generation 1 went into the FIFO, which can't be synced, so it fails and is never renamed into place; 3 and 4
+    // are written normally and the newest wins.
+    CHECK(!writer.lastError().empty());
+    CHECK(writer.written() == 2);
+    CHECK(generationIn(path) == 4);
+    CHECK(!std::filesystem::exists(temporary));
+}
+#endif
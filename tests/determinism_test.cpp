@@ -0,0 +1,78 @@
+#include "test.hpp"
+
+#include "neat_core/checkpoint.hpp"
+#include "sim/simulation.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// A run seed has to reproduce the same run bit for bit whatever the thread count, and a resumed run has to carry
+// on exactly as if it had never stopped. Both are checked on the boss-fight task, kept short so the suite is quick.
+
+namespace {
+
+std::vector<char> readFile(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+sim::SimulationConfig encounterConfig(std::size_t threads)
+{
+
+    sim::SimulationConfig config;
+    config.task = sim::Task::Encounter;
+    config.population.size = 48;
+    config.population.seed = 9;
+    config.encounter.max_ticks = 240;
+    config.showcase_ticks = 1; // Breed every tick
+    config.threads = threads;
+    return config;
+}
+
+// Runs `simulation` up to `generation` and saves it to `path`, returning the file's bytes.
+std::vector<char> runAndSave(sim::Simulation &simulation, std::uint64_t generation, const std::string &path)
+{
+
+    while (simulation.getPopulation().generation() < generation)
+    {
+        simulation.tick();
+    }
+    neat::writeCheckpoint(simulation.getPopulation().snapshot().view(), path);
+    return readFile(path);
+}
+
+} // namespace
+
+TEST_CASE(determinism, same_checkpoint_at_any_thread_count)
+{
+
+    sim::Simulation one_thread(encounterConfig(1));
+    sim::Simulation four_threads(encounterConfig(4));
+
+    const std::vector<char> a = runAndSave(one_thread, 4, "determinism_1.ckpt");
+    const std::vector<char> b = runAndSave(four_threads, 4, "determinism_4.ckpt");
+    CHECK(!a.empty());
+    CHECK(a == b);
+}
+
+TEST_CASE(determinism, resume_is_bit_identical)
+{
+
+    sim::Simulation straight(encounterConfig(2));
+    const std::vector<char> expected = runAndSave(straight, 4, "resume_straight.ckpt");
+
+    sim::Simulation first_half(encounterConfig(2));
+    runAndSave(first_half, 2, "resume_half.ckpt");
+
+    // Resumed on a different thread count, for good measure.
+    sim::Simulation second_half(encounterConfig(3));
+    {
+        neat::MappedCheckpoint checkpoint("resume_half.ckpt");
+        second_half.restore(checkpoint.view());
+    }
+    CHECK(second_half.getPopulation().generation() == 2);
+    CHECK(runAndSave(second_half, 4, "resume_resumed.ckpt") == expected);
+}
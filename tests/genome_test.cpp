@@ -0,0 +1,168 @@
+#include "test.hpp"
+
+#include "neat_core/genome.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using neat::Genome;
+using neat::NodeType;
+
+namespace {
+
+struct Gene {
+    std::uint32_t innovation, in, out;
+    float weight;
+    std::uint8_t enabled;
+};
+
+// 2 inputs (ids 0, 1), bias (2), output (3) and one hidden node (4).
+Genome makeGenome(const std::vector<Gene> &genes)
+{
+
+    const std::uint32_t node_ids[] = {0, 1, 2, 3, 4};
+    const NodeType node_types[] = {NodeType::Input, NodeType::Input, NodeType::Bias, NodeType::Output,
+                                   NodeType::Hidden};
+
+    std::vector<std::uint32_t> innovations, in, out;
+    std::vector<float> weights;
+    std::vector<std::uint8_t> enabled;
+    for (const Gene &gene : genes)
+    {
+        innovations.push_back(gene.innovation);
+        in.push_back(gene.in);
+        out.push_back(gene.out);
+        weights.push_back(gene.weight);
+        enabled.push_back(gene.enabled);
+    }
+
+    return Genome::fromGenes(2, 1, node_ids, node_types, 5, innovations.data(), in.data(), out.data(),
+                             weights.data(), enabled.data(), genes.size());
+}
+
+// Innovations 0, 1, 3
+Genome parentA()
+{
+    return makeGenome({{0, 0, 3, 0.5f, 1}, {1, 1, 3, 1.0f, 0}, {3, 0, 4, -1.0f, 1}});
+}
+
+// Innovations 0, 2, 3, 4; gene 3 disabled
+Genome parentB()
+{
+    return makeGenome({{0, 0, 3, 1.5f, 1}, {2, 2, 3, 0.0f, 1}, {3, 0, 4, -0.5f, 0}, {4, 4, 3, 2.0f, 1}});
+}
+
+} // namespace
+
+TEST_CASE(genome, distance_matches_hand_computed)
+{
+
+    // Merge of {0, 1, 3} with {0, 2, 3, 4}: 0 and 3 match (weight differences 1.0 and 0.5), 1 and 2 are disjoint,
+    // 4 is excess. N = 4.
+    const Genome a = parentA();
+    const Genome b = parentB();
+
+    neat::CompatibilityConfig config;
+    config.excess_coefficient = 1.0f;
+    config.disjoint_coefficient = 1.0f;
+    config.weight_coefficient = 0.4f;
+    CHECK_NEAR(Genome::compatibilityDistance(a, b, config), (1 * 1 + 1 * 2) / 4.0 + 0.4 * 0.75, 1e-6);
+    CHECK_NEAR(Genome::compatibilityDistance(b, a, config), (1 * 1 + 1 * 2) / 4.0 + 0.4 * 0.75, 1e-6);
+
+    config.excess_coefficient = 2.0f;
+    config.disjoint_coefficient = 3.0f;
+    config.weight_coefficient = 0.5f;
+    CHECK_NEAR(Genome::compatibilityDistance(a, b, config), (2 * 1 + 3 * 2) / 4.0 + 0.5 * 0.75, 1e-6);
+
+    CHECK(Genome::compatibilityDistance(a, a, config) == 0.0f);
+}
+
+TEST_CASE(genome, distance_limit_only_cuts_off_above_it)
+{
+
+    const Genome a = parentA();
+    const Genome b = parentB();
+    const neat::CompatibilityConfig config;
+    const float exact = Genome::compatibilityDistance(a, b, config);
+
+    // Within the limit the answer is exact; past it, anything over the limit will do.
+    CHECK(Genome::compatibilityDistance(a, b, config, exact) == exact);
+    CHECK(Genome::compatibilityDistance(a, b, config, exact + 1.0f) == exact);
+    CHECK(Genome::compatibilityDistance(a, b, config, 0.1f) > 0.1f);
+    CHECK(Genome::compatibilityDistance(a, b, config, 0.0f) > 0.0f);
+}
+
+TEST_CASE(genome, distance_of_empty_genomes)
+{
+
+    const Genome empty = makeGenome({});
+    const Genome a = parentA();
+    neat::CompatibilityConfig config;
+    config.excess_coefficient = 1.0f;
+
+    CHECK(Genome::compatibilityDistance(empty, empty, config) == 0.0f);
+    CHECK_NEAR(Genome::compatibilityDistance(empty, a, config), 3 / 3.0, 1e-6); // All excess, N = 3
+}
+
+TEST_CASE(genome, crossover_takes_structure_from_fitter)
+{
+
+    const Genome a = parentA();
+    const Genome b = parentB();
+    neat::MutationConfig config;
+    config.disabled_inherit_rate = 1.0f; // A gene off in either parent always stays off
+
+    bool weight_from_a = false;
+    bool weight_from_b = false;
+    for (std::uint64_t seed = 1; seed <= 64; ++seed)
+    {
+        neat::Rng rng(seed);
+        const Genome child = Genome::crossover(a, b, rng, config);
+
+        // Exactly the fitter parent's genes and nodes, in order.
+        CHECK(child.connectionCount() == 3);
+        CHECK((std::vector<std::uint32_t>(child.connectionInnovations().begin(), child.connectionInnovations().end()) ==
+               std::vector<std::uint32_t>{0, 1, 3}));
+        CHECK(child.nodeIds() == a.nodeIds());
+        CHECK(child.nodeTypes() == a.nodeTypes());
+        CHECK(child.connectionIn() == a.connectionIn());
+        CHECK(child.connectionOut() == a.connectionOut());
+
+        // Matching genes 0 and 3 take either parent's weight; disjoint gene 1 is the fitter parent's, disabled
+        // state and all.
+        const auto &weights = child.connectionWeights();
+        CHECK(weights[0] == 0.5f || weights[0] == 1.5f);
+        CHECK(weights[2] == -1.0f || weights[2] == -0.5f);
+        CHECK(weights[1] == 1.0f);
+        weight_from_a = weight_from_a || weights[0] == 0.5f;
+        weight_from_b = weight_from_b || weights[0] == 1.5f;
+
+        const auto &enabled = child.connectionEnabled();
+        CHECK(enabled[0] == 1);
+        CHECK(enabled[1] == 0);
+        CHECK(enabled[2] == 0); // Disabled in b
+    }
+    CHECK(weight_from_a);
+    CHECK(weight_from_b);
+
+    // With inherit rate 0 a gene disabled in only one parent is always turned back on.
+    config.disabled_inherit_rate = 0.0f;
+    neat::Rng rng(7);
+    const Genome child = Genome::crossover(a, b, rng, config);
+    CHECK(child.connectionEnabled()[2] == 1);
+    CHECK(child.connectionEnabled()[1] == 0); // Disjoint, so never re-rolled
+}
+
+TEST_CASE(genome, crossover_with_itself_is_a_copy)
+{
+
+    const Genome a = parentA();
+    neat::MutationConfig config;
+    config.disabled_inherit_rate = 1.0f;
+    neat::Rng rng(3);
+    const Genome child = Genome::crossover(a, a, rng, config);
+
+    CHECK(child.connectionInnovations() == a.connectionInnovations());
+    CHECK(child.connectionWeights() == a.connectionWeights());
+    CHECK(child.connectionEnabled() == a.connectionEnabled());
+}
@@ -0,0 +1,149 @@
+#include "test.hpp"
+
+#include "neat_core/rng.hpp"
+#include "sim/metric_store.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using sim::MetricBucket;
+using sim::MetricSeries;
+
+namespace {
+
+struct Series {
+    MetricSeries series;
+    std::vector<float> raw;
+
+    void append(float value)
+    {
+        series.append(value);
+        raw.push_back(value);
+    }
+};
+
+// Buckets are contiguous, cover [first, last), stay within max_buckets + 1 and hold exact min/max of the raw
+// samples they cover.
+bool downsampleMatches(const Series &s, std::uint64_t first, std::uint64_t last, std::size_t max_buckets)
+{
+
+    std::vector<MetricBucket> out;
+    s.series.downsample(first, last, max_buckets, out);
+
+    last = std::min<std::uint64_t>(last, s.raw.size());
+    if (first >= last)
+    {
+        return out.empty();
+    }
+    if (out.empty() || out.size() > std::max<std::size_t>(1, max_buckets) + 1)
+    {
+        return false;
+    }
+    if (out.front().first > first || out.back().first + out.back().count < last)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        const MetricBucket &bucket = out[i];
+        if (bucket.count == 0 || bucket.first + bucket.count > s.raw.size() ||
+            (i > 0 && out[i - 1].first + out[i - 1].count != bucket.first))
+        {
+            return false;
+        }
+
+        const auto begin = s.raw.begin() + bucket.first;
+        const auto end = begin + bucket.count;
+        if (*std::min_element(begin, end) != bucket.min || *std::max_element(begin, end) != bucket.max)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE(metric_series, empty_and_degenerate_ranges)
+{
+
+    Series s;
+    CHECK(s.series.latest() == 0.0f);
+    std::vector<MetricBucket> out{{0, 1, 0.0f, 0.0f}};
+    s.series.downsample(0, 100, 10, out);
+    CHECK(out.empty()); // Nothing appended yet, and the old contents are replaced
+
+    s.append(3.0f);
+    CHECK(s.series.size() == 1);
+    CHECK(downsampleMatches(s, 0, 1, 10));
+    CHECK(downsampleMatches(s, 0, 1000, 10)); // last past the end is clamped
+    CHECK(downsampleMatches(s, 1, 1, 10));    // Empty range
+    CHECK(downsampleMatches(s, 5, 2, 10));    // Backwards range
+    CHECK(downsampleMatches(s, 0, 1, 0));     // Zero buckets is treated as one
+
+    CHECK(s.series.latest() == 3.0f);
+    s.series.downsample(0, 1, 10, out);
+    CHECK(out.size() == 1);
+    CHECK(out[0].first == 0 && out[0].count == 1 && out[0].min == 3.0f && out[0].max == 3.0f);
+}
+
+TEST_CASE(metric_series, level_boundaries)
+{
+
+    // Sizes either side of whole buckets at the first few levels and of the first ring wrapping.
+    const std::uint64_t f = MetricSeries::fan_out;
+    const std::uint64_t sizes[] = {f - 1,     f,         f + 1,
+                                   f * f - 1, f * f,     f * f + 1,
+                                   f * f * f, MetricSeries::level_capacity, MetricSeries::level_capacity + 1};
+    const std::size_t bucket_limits[] = {0, 1, 2, 7, 8, 9, 63, 64, 65, 4096};
+
+    neat::Rng rng(21);
+    Series s;
+    for (const std::uint64_t size : sizes)
+    {
+        while (s.raw.size() < size)
+        {
+            s.append(neat::randomFloat(rng, -1.0f, 1.0f));
+        }
+
+        for (const std::size_t max_buckets : bucket_limits)
+        {
+            CHECK(downsampleMatches(s, 0, size, max_buckets));
+            CHECK(downsampleMatches(s, size - 1, size, max_buckets)); // Just the newest sample
+            CHECK(downsampleMatches(s, 0, 1, max_buckets));           // Just the oldest
+            CHECK(downsampleMatches(s, size / 2, size / 2 + f, max_buckets));
+        }
+    }
+}
+
+TEST_CASE(metric_series, long_history_random_ranges)
+{
+
+    // Long enough for the finest levels' rings to have wrapped several times.
+    neat::Rng rng(22);
+    Series s;
+    for (std::size_t n = 0; n < 300000; ++n)
+    {
+        s.append(neat::randomFloat(rng, -1.0f, 1.0f));
+    }
+
+    bool all_match = true;
+    for (int query = 0; query < 200; ++query)
+    {
+        const std::uint64_t first = neat::randomIndex(rng, s.raw.size());
+        const std::uint64_t last = first + 1 + neat::randomIndex(rng, s.raw.size() - first);
+        const std::size_t max_buckets = 1 + neat::randomIndex(rng, 3000);
+        all_match = all_match && downsampleMatches(s, first, last, max_buckets);
+    }
+    CHECK(all_match);
+
+    // Recent history is still exact, sample by sample.
+    std::vector<MetricBucket> out;
+    const std::uint64_t size = s.series.size();
+    s.series.downsample(size - 100, size, 100, out);
+    CHECK(out.size() == 100);
+    CHECK(!out.empty() && out.front().first == size - 100 && out.front().count == 1);
+    CHECK(s.series.latest() == s.raw.back());
+}
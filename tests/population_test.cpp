@@ -0,0 +1,118 @@
+#include "test.hpp"
+
+#include "neat_core/checkpoint.hpp"
+#include "neat_core/fitness.hpp"
+#include "neat_core/population.hpp"
+#include "neat_core/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+bool sameGenes(const neat::Genome &a, const neat::Genome &b)
+{
+    return a.nodeIds() == b.nodeIds() && a.connectionInnovations() == b.connectionInnovations() &&
+           a.connectionWeights() == b.connectionWeights() && a.connectionEnabled() == b.connectionEnabled();
+}
+
+// Fitness is the network's output with both inputs at zero, i.e. set by the bias -> output weight alone.
+float biasOutput(neat::Network &network, neat::Rng &)
+{
+    const float inputs[2] = {0.0f, 0.0f};
+    float output = 0.0f;
+    network.activate(inputs, &output);
+    return output;
+}
+
+} // namespace
+
+TEST_CASE(population, champion_survives_a_species_rounded_to_nothing)
+{
+
+    // 24 genomes: the champion (~1.0) shares a species with 11 duds (~0.0), and the other 12 are good (~0.99)
+    // singletons. The champion's species averages ~0.08 against ~0.99 for each singleton, so proportional shares
+    // alone would give it no offspring at all.
+    neat::PopulationConfig config;
+    config.size = 24;
+
+    neat::ThreadPool pool(1);
+    neat::FitnessEvaluator evaluator(pool, biasOutput);
+    neat::Population population(config, &pool);
+
+    const neat::PopulationSnapshot fresh = population.snapshot();
+    neat::PopulationSnapshot crafted;
+    crafted.header = fresh.header;
+    crafted.rng_state = fresh.rng_state;
+
+    const std::uint32_t bias = config.num_inputs;
+    auto addGenome = [&](std::size_t index) {
+        const neat::Genome &genome = population.getGenomes()[index];
+        const std::size_t first = crafted.conn_weight.size();
+        crafted.addGenome(genome);
+
+        const float bias_weight = index == 0 ? 2.0f : index < 12 ? -2.0f : 1.0f;
+        for (std::size_t c = first; c < crafted.conn_weight.size(); ++c)
+        {
+            crafted.conn_weight[c] = crafted.conn_in[c] == bias ? bias_weight : 0.0f;
+        }
+    };
+
+    for (std::size_t i = 0; i < config.size; ++i)
+    {
+        addGenome(i);
+    }
+    for (std::uint32_t s = 0; s < 13; ++s)
+    {
+        const std::size_t first_member = s == 0 ? 0 : 11 + s;
+        const std::uint32_t member_count = s == 0 ? 12 : 1;
+        addGenome(first_member); // Representative
+
+        neat::SpeciesRecord record;
+        record.first_member = crafted.members.size();
+        record.last_improved = crafted.header.generation;
+        record.id = s;
+        record.member_count = member_count;
+        crafted.species.push_back(record);
+        for (std::uint32_t m = 0; m < member_count; ++m)
+        {
+            crafted.members.push_back(static_cast<std::uint32_t>(first_member + m));
+        }
+    }
+    crafted.header.next_species_id = 13;
+
+    population.restore(crafted.view());
+    const neat::Genome champion = population.getGenomes()[0];
+
+    population.epoch(evaluator);
+
+    const auto &next = population.getGenomes();
+    CHECK(next.size() == config.size);
+    CHECK(std::any_of(next.begin(), next.end(), [&](const neat::Genome &g) { return sameGenes(g, champion); }));
+}
+
+TEST_CASE(population, breeds_after_restoring_without_species)
+{
+
+    // restore() takes a view as given (MappedCheckpoint refuses such a file); breeding must still not divide by an
+    // empty species list.
+    neat::PopulationConfig config;
+    config.size = 30;
+
+    neat::ThreadPool pool(1);
+    neat::FitnessEvaluator evaluator(pool, biasOutput);
+    neat::Population population(config, &pool);
+
+    neat::PopulationSnapshot snapshot = population.snapshot();
+    snapshot.genomes.resize(snapshot.genomes.size() - snapshot.species.size());
+    snapshot.species.clear();
+    snapshot.members.clear();
+    population.restore(snapshot.view());
+    CHECK(population.getSpecies().empty());
+
+    population.epoch(evaluator);
+    CHECK(population.size() == config.size);
+    CHECK(!population.getSpecies().empty());
+}
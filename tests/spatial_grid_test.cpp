@@ -0,0 +1,165 @@
+#include "test.hpp"
+
+#include "neat_core/rng.hpp"
+#include "sim/spatial_grid.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using sim::SpatialGrid;
+
+namespace {
+
+constexpr float extent = 20.0f;
+constexpr std::uint32_t layer_count = 3;
+
+struct Points {
+    std::vector<float> xs, ys;
+    std::vector<std::uint32_t> layers;
+};
+
+// Random points inside [-extent, extent]^2, some on the edges and some stacked on one spot.
+Points randomPoints(neat::Rng &rng, std::size_t count)
+{
+
+    Points points;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float x = neat::randomFloat(rng, -extent, extent);
+        float y = neat::randomFloat(rng, -extent, extent);
+        if (i % 17 == 0)
+        {
+            x = i % 2 ? extent : -extent;
+        }
+        if (i % 23 == 0)
+        {
+            x = 1.0f;
+            y = 1.0f;
+        }
+        points.xs.push_back(x);
+        points.ys.push_back(y);
+        points.layers.push_back(static_cast<std::uint32_t>(neat::randomIndex(rng, layer_count)));
+    }
+    return points;
+}
+
+float distanceSquared(const Points &points, std::size_t i, float x, float y)
+{
+    const float dx = points.xs[i] - x;
+    const float dy = points.ys[i] - y;
+    return dx * dx + dy * dy;
+}
+
+} // namespace
+
+TEST_CASE(spatial_grid, radius_query_matches_brute_force)
+{
+
+    neat::Rng rng(11);
+    const Points points = randomPoints(rng, 500);
+
+    SpatialGrid grid(-extent, -extent, extent, extent, 3.0f, layer_count);
+    grid.build(points.xs.data(), points.ys.data(), points.xs.size(), points.layers.data());
+    CHECK(grid.pointCount() == points.xs.size());
+
+    for (int query = 0; query < 300; ++query)
+    {
+        // Includes queries centred outside the grid and radii covering all of it.
+        const float x = neat::randomFloat(rng, -extent - 5.0f, extent + 5.0f);
+        const float y = neat::randomFloat(rng, -extent - 5.0f, extent + 5.0f);
+        const float radius = query % 10 == 0 ? 100.0f : neat::randomFloat(rng, 0.0f, 8.0f);
+        const std::uint32_t layer = query % layer_count;
+
+        std::vector<std::uint32_t> found;
+        bool distances_right = true;
+        grid.forEachInRadius(layer, x, y, radius, [&](std::uint32_t index, float distance_squared) {
+            found.push_back(index);
+            distances_right = distances_right && distance_squared == distanceSquared(points, index, x, y);
+        });
+        CHECK(distances_right);
+
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t i = 0; i < points.xs.size(); ++i)
+        {
+            if (points.layers[i] == layer && distanceSquared(points, i, x, y) <= radius * radius)
+            {
+                expected.push_back(i);
+            }
+        }
+
+        std::sort(found.begin(), found.end());
+        CHECK(found == expected);
+    }
+}
+
+TEST_CASE(spatial_grid, nearest_matches_brute_force)
+{
+
+    neat::Rng rng(12);
+    const Points points = randomPoints(rng, 400);
+
+    SpatialGrid grid(-extent, -extent, extent, extent, 2.5f, layer_count);
+    grid.build(points.xs.data(), points.ys.data(), points.xs.size(), points.layers.data());
+
+    for (int query = 0; query < 300; ++query)
+    {
+        const float x = neat::randomFloat(rng, -extent, extent);
+        const float y = neat::randomFloat(rng, -extent, extent);
+        const std::uint32_t layer = query % layer_count;
+        const std::size_t k = 1 + neat::randomIndex(rng, SpatialGrid::max_nearest + 4); // Sometimes over the cap
+        const float max_radius = query % 3 == 0 ? neat::randomFloat(rng, 0.5f, 10.0f) : extent * 4.0f;
+        auto accept = [](std::uint32_t index) { return index % 5 != 0; };
+
+        std::uint32_t out[SpatialGrid::max_nearest];
+        const std::size_t found = grid.nearest(layer, x, y, k, out, accept, max_radius);
+
+        std::vector<float> expected;
+        for (std::uint32_t i = 0; i < points.xs.size(); ++i)
+        {
+            const float d = distanceSquared(points, i, x, y);
+            if (points.layers[i] == layer && accept(i) && d <= max_radius * max_radius)
+            {
+                expected.push_back(d);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        expected.resize(std::min({expected.size(), k, SpatialGrid::max_nearest}));
+
+        // Compared by distance, since ties may come back in either order.
+        CHECK(found == expected.size());
+        bool distances_right = true;
+        for (std::size_t i = 0; i < std::min(found, expected.size()); ++i)
+        {
+            distances_right = distances_right && points.layers[out[i]] == layer && accept(out[i]) &&
+                              distanceSquared(points, out[i], x, y) == expected[i];
+        }
+        CHECK(distances_right);
+    }
+}
+
+TEST_CASE(spatial_grid, empty_and_single_layer)
+{
+
+    SpatialGrid grid(0.0f, 0.0f, 10.0f, 10.0f, 1.0f);
+    grid.build(nullptr, nullptr, 0);
+    CHECK(grid.pointCount() == 0);
+
+    std::uint32_t out[SpatialGrid::max_nearest];
+    CHECK(grid.nearest(0, 5.0f, 5.0f, 4, out, [](std::uint32_t) { return true; }) == 0);
+
+    const float xs[] = {1.0f, 9.0f, 5.0f};
+    const float ys[] = {1.0f, 9.0f, 5.5f};
+    grid.build(xs, ys, 3);
+    CHECK(grid.nearest(0, 5.0f, 5.0f, 0, out, [](std::uint32_t) { return true; }) == 0);
+    CHECK(grid.nearest(0, 5.0f, 5.0f, 2, out, [](std::uint32_t) { return true; }) == 2);
+    CHECK(out[0] == 2);
+    CHECK(out[1] == 0 || out[1] == 1); // Equally far
+
+    int visited = 0;
+    grid.forEachInRadius(0, 5.0f, 5.0f, 0.5f, [&](std::uint32_t index, float) {
+        CHECK(index == 2);
+        ++visited;
+    });
+    CHECK(visited == 1);
+}
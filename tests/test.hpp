@@ -0,0 +1,55 @@
+#pragma once
+
+// Tiny self-registering test harness, so the tests build wherever neat_core does with no extra dependencies.
+// TEST_CASE(suite, name) defines a test; neat_tests runs every test, or only one suite's when given its name.
+
+#include <cmath>
+#include <cstddef>
+
+namespace test {
+
+using TestFunction = void (*)();
+
+struct Register {
+    Register(const char *suite, const char *name, TestFunction function);
+};
+
+// Records a failed check and carries on, so one run reports every broken expectation in a test.
+void fail(const char *file, int line, const char *expression);
+
+} // namespace test
+
+#define TEST_CASE(suite, name)                                                                                         \
+    static void suite##_##name();                                                                                      \
+    static const test::Register suite##_##name##_register(#suite, #name, suite##_##name);                              \
+    static void suite##_##name()
+
+#define CHECK(expression)                                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expression))                                                                                             \
+        {                                                                                                              \
+            test::fail(__FILE__, __LINE__, #expression);                                                               \
+        }                                                                                                              \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tolerance) CHECK(std::fabs(double(a) - double(b)) <= (tolerance))
+
+// Passes if `statement` throws `type`.
+#define CHECK_THROWS(statement, type)                                                                                  \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        bool threw = false;                                                                                            \
+        try                                                                                                            \
+        {                                                                                                              \
+            statement;                                                                                                 \
+        }                                                                                                              \
+        catch (const type &)                                                                                           \
+        {                                                                                                              \
+            threw = true;                                                                                              \
+        }                                                                                                              \
+        if (!threw)                                                                                                    \
+        {                                                                                                              \
+            test::fail(__FILE__, __LINE__, #statement " throws " #type);                                               \
+        }                                                                                                              \
+    } while (0)
@@ -0,0 +1,83 @@
+// neat_tests - runs the TEST_CASEs linked into it. `neat_tests SUITE` runs one suite (what ctest does, one test
+// per suite); no argument runs everything. Exits non-zero if any check failed.
+
+#include "test.hpp"
+
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+namespace test {
+
+namespace {
+
+struct TestEntry {
+    const char *suite;
+    const char *name;
+    TestFunction function;
+};
+
+// Function-local so registration from other translation units doesn't depend on static initialisation order.
+std::vector<TestEntry> &registry()
+{
+    static std::vector<TestEntry> tests;
+    return tests;
+}
+
+int failures = 0;
+
+} // namespace
+
+Register::Register(const char *suite, const char *name, TestFunction function)
+{
+    registry().push_back({suite, name, function});
+}
+
+void fail(const char *file, int line, const char *expression)
+{
+
+    ++failures;
+    std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+}
+
+} // namespace test
+
+int main(int argc, char **argv)
+{
+
+    const char *suite = argc > 1 ? argv[1] : nullptr;
+    std::size_t run = 0;
+
+    for (const test::TestEntry &entry : test::registry())
+    {
+        if (suite && std::strcmp(suite, entry.suite) != 0)
+        {
+            continue;
+        }
+
+        const int failures_before = test::failures;
+        try
+        {
+            entry.function();
+        }
+        catch (const std::exception &e)
+        {
+            ++test::failures;
+            std::cerr << entry.suite << "." << entry.name << ": unexpected exception: " << e.what() << std::endl;
+        }
+
+        std::cout << (test::failures == failures_before ? "pass  " : "FAIL  ") << entry.suite << "." << entry.name
+                  << std::endl;
+        ++run;
+    }
+
+    if (run == 0)
+    {
+        std::cerr << "No tests in suite " << (suite ? suite : "(all)") << std::endl;
+        return 1;
+    }
+
+    std::cout << run << " tests, " << test::failures << " failed checks" << std::endl;
+    return test::failures == 0 ? 0 : 1;
+}